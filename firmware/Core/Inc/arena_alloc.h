@@ -0,0 +1,51 @@
+#ifndef ARENA_ALLOC_H
+#define ARENA_ALLOC_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+/**
+ * @brief  Fill level of the arena.
+ */
+typedef struct {
+    size_t size;        /* bytes in the buffer */
+    size_t used;        /* bytes up to the top block now (headers included) */
+    size_t peak;        /* highest used since arena_alloc_init() or arena_reset_peak() */
+    uint32_t failed;    /* calloc calls that did not fit */
+} arena_stats_t;
+
+/**
+ * @brief  Hands the arena a buffer (8-byte aligned) and empties it.
+ */
+void arena_alloc_init(void *buf, size_t size);
+
+/**
+ * @brief  Bump allocation from the top of the arena, zeroed; NULL if the
+ *         arena is full. Blocks are 8-byte aligned.
+ */
+void *arena_calloc(size_t n, size_t size);
+
+/**
+ * @brief  Marks a block free. Only blocks at the top give their memory
+ *         back (together with any freed blocks right below them); the
+ *         rest stays in place until arena_reset().
+ */
+void arena_free(void *ptr);
+
+/**
+ * @brief  Releases every block at once. Nothing allocated from the arena
+ *         may be used afterwards.
+ */
+void arena_reset(void);
+
+/**
+ * @brief  Restarts the high-water mark from the current fill level.
+ */
+void arena_reset_peak(void);
+
+/**
+ * @brief  Reads the fill level.
+ */
+void arena_get(arena_stats_t *out);
+
+#endif /* ARENA_ALLOC_H */
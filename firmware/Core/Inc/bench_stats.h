@@ -0,0 +1,33 @@
+#ifndef BENCH_STATS_H
+#define BENCH_STATS_H
+
+#include <stdint.h>
+
+/* Capacity of the on-device sample buffer (per benchmarked operation) */
+#ifndef BENCH_MAX_SAMPLES
+#define BENCH_MAX_SAMPLES 32
+#endif
+
+/**
+ * @brief  Summary statistics of one benchmarked operation.
+ */
+typedef struct {
+    uint32_t n;
+    uint64_t min;
+    uint64_t median;
+    uint64_t p90;
+    uint64_t max;
+    uint64_t mean;
+    uint64_t stddev;
+} bench_stats_t;
+
+/**
+ * @brief  Computes min/median/p90/max/mean/stddev over a set of samples.
+ *         The samples are sorted in place.
+ * @param  samples Cycle counts, one per iteration.
+ * @param  n       Number of samples (may be 0).
+ * @param  out     Resulting statistics.
+ */
+void bench_stats_compute(uint64_t *samples, uint32_t n, bench_stats_t *out);
+
+#endif /* BENCH_STATS_H */
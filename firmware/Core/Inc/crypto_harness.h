@@ -8,9 +8,38 @@
  */
 void benchmark_rsa_suite(void);
 
+/**
+ * @brief  Runs the RSA key generation benchmarks (opt-in: billions of
+ *         cycles per key; the RSA suite imports pre-generated keys).
+ */
+void benchmark_rsa_keygen(void);
+
 /**
  * @brief  Runs a PQC Dilithium2/Kyber benchmark and prints cycles to UART.
  */
 void benchmark_pqc(void);
 
+/**
+ * @brief  Selects the result format.
+ * @param  enable Non-zero: one COBS-framed binary record per measured run
+ *                (see telemetry.h, decoded by scripts/telemetry.py).
+ *                Zero: "UART >> ..." text lines (default).
+ */
+void benchmark_set_binary_output(int enable);
+
+/**
+ * @brief  Prints the name of every registered benchmark to UART.
+ */
+void benchmark_list(void);
+
+/**
+ * @brief  Runs the registered benchmarks matching a name.
+ * @param  name Either "<Algorithm> <Operation>" (e.g. "ML-KEM-512 Encaps")
+ *              or just "<Algorithm>" to run all its operations except
+ *              the opt-in RSA KeyGen ones.
+ *              Matching is case-insensitive.
+ * @return Number of benchmarks run (0 if the name is unknown).
+ */
+int benchmark_run_by_name(const char *name);
+
 #endif /* __CRYPTO_HARNESS_H */
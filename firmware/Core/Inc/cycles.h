@@ -2,7 +2,18 @@
 #define __CYCLES_H
 
 #include <stdint.h>
+#ifndef PQC_HOST
 #include "stm32f7xx.h"
+#endif
+
+/**
+ * @brief  Software extension state for the 32-bit DWT cycle counter.
+ *         `high` counts observed wraps, `last` is the previous raw sample.
+ */
+typedef struct {
+    uint32_t high;
+    uint32_t last;
+} cycles_ext_t;
 
 /**
  * @brief  Initializes the DWT cycle counter.
@@ -11,18 +22,59 @@
 void cycles_init(void);
 
 /**
- * @brief  Resets the cycle counter to zero.
+ * @brief  Resets the cycle counter (and its 64-bit extension) to zero.
  */
-static inline void cycles_reset(void) {
-    DWT->CYCCNT = 0;
-}
+void cycles_reset(void);
 
 /**
  * @brief  Returns the current 32-bit cycle count.
- * @return Current value of DWT->CYCCNT.
+ * @return Current value of DWT->CYCCNT (host build: low word of the TSC).
  */
+#ifdef PQC_HOST
+uint32_t cycles_get(void);
+#else
 static inline uint32_t cycles_get(void) {
     return DWT->CYCCNT;
 }
+#endif
+
+/**
+ * @brief  Folds a raw 32-bit sample into the 64-bit extension state.
+ *         A sample smaller than the previous one means CYCCNT wrapped.
+ *         Correct as long as it is called at least once per wrap period.
+ * @param  ext Extension state.
+ * @param  now Raw CYCCNT sample.
+ * @return 64-bit cycle count.
+ */
+static inline uint64_t cycles_extend(cycles_ext_t *ext, uint32_t now) {
+    if (now < ext->last) {
+        ext->high++;
+    }
+    ext->last = now;
+    return ((uint64_t)ext->high << 32) | now;
+}
+
+/**
+ * @brief  Returns the current 64-bit cycle count.
+ *         CYCCNT wraps every ~19.9 s at 216 MHz; the wrap is tracked in
+ *         software and cycles_poll() (called from SysTick) guarantees that
+ *         no wrap is missed while nobody reads the counter.
+ * @return Wrap-safe cycle count.
+ */
+uint64_t cycles_get64(void);
+
+/**
+ * @brief  Returns the cycles elapsed since a cycles_get64() sample.
+ * @param  start Earlier value returned by cycles_get64().
+ */
+static inline uint64_t cycles_elapsed64(uint64_t start) {
+    return cycles_get64() - start;
+}
+
+/**
+ * @brief  Samples the counter to keep the 64-bit extension up to date.
+ *         Must run at least once per wrap period (SysTick_Handler does).
+ */
+void cycles_poll(void);
 
 #endif /* __CYCLES_H */
@@ -0,0 +1,53 @@
+#ifndef HEAP_STATS_H
+#define HEAP_STATS_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+/**
+ * @brief  Heap usage of one measured region (see heap_stats_reset()).
+ */
+typedef struct {
+    size_t current;     /* bytes live now (all regions) */
+    size_t peak;        /* highest live bytes above the level at reset */
+    uint32_t allocs;    /* successful calloc calls since reset */
+    uint32_t frees;     /* free calls (non-NULL) since reset */
+    uint32_t cycles;    /* cycles spent in the backend (calloc + free) since reset */
+    uint32_t worst;     /* slowest single backend call since reset */
+} heap_stats_t;
+
+/**
+ * @brief  Allocator the shim forwards to (calloc/free by default).
+ */
+typedef void *(*heap_stats_calloc_fn_t)(size_t n, size_t size);
+typedef void (*heap_stats_free_fn_t)(void *ptr);
+
+/**
+ * @brief  Installs the instrumented allocator as mbedTLS calloc/free
+ *         (MBEDTLS_PLATFORM_MEMORY). Call before any mbedTLS allocation.
+ */
+void heap_stats_init(void);
+
+/**
+ * @brief  Replaces the underlying allocator. Only valid while nothing
+ *         allocated through the shim is still live.
+ */
+void heap_stats_set_backend(heap_stats_calloc_fn_t calloc_fn, heap_stats_free_fn_t free_fn);
+
+/**
+ * @brief  Reads the current underlying allocator (to restore it later).
+ */
+void heap_stats_get_backend(heap_stats_calloc_fn_t *calloc_fn, heap_stats_free_fn_t *free_fn);
+
+/**
+ * @brief  Starts a new measured region: clears counters, peak restarts
+ *         from the current live size.
+ */
+void heap_stats_reset(void);
+
+/**
+ * @brief  Reads the statistics of the current region.
+ */
+void heap_stats_get(heap_stats_t *out);
+
+#endif /* HEAP_STATS_H */
@@ -13,6 +13,13 @@
 #define MBEDTLS_PLATFORM_STD_CALLOC calloc
 #define MBEDTLS_PLATFORM_STD_FREE free
 
+/* mbedtls_memory_buffer_alloc as an alternative heap_stats backend (RSA
+ * "Buffer Alloc" entries); mbedtls_memory_buffer_calloc()/_free() are a
+ * local extension in deps/mbedtls/library/memory_buffer_alloc.c. 8-byte
+ * blocks, as newlib malloc and the arena hand out. */
+#define MBEDTLS_MEMORY_BUFFER_ALLOC_C
+#define MBEDTLS_MEMORY_ALIGN_MULTIPLE 8
+
 /* Mbed TLS feature support */
 #define MBEDTLS_RSA_C
 #define MBEDTLS_BIGNUM_C
@@ -23,6 +30,25 @@
 #define MBEDTLS_CIPHER_C
 #define MBEDTLS_GENPRIME
 
+/* Local extension (deps/mbedtls/library/bignum.c): incremental small-prime
+ * sieve in mbedtls_mpi_gen_prime(); mbedtls_mpi_gen_prime_set_sieve(0)
+ * restores the stock search at run time */
+#define MBEDTLS_GENPRIME_SIEVE
+
+/* Local extension (deps/mbedtls/library/rsa.c, bignum_core.c):
+ * mbedtls_rsa_private_restartable(), the CRT private op split into calls
+ * of at most mbedtls_rsa_set_max_ops() Montgomery multiplications */
+#define MBEDTLS_RSA_RESTARTABLE
+
+/* Local extension (deps/mbedtls/library/bn_mul.h): Cortex-M7 MULADDC
+ * kernel, 4 limbs per LDRD/UMAAL block, 8 per loop step of
+ * mbedtls_mpi_core_mla(). Opt-in until it has been measured on the board:
+ * the pqc_demo_muladdc_m7 target defines PQC_MULADDC_M7, the default
+ * images keep the stock DSP kernel. */
+#if defined(PQC_MULADDC_M7)
+#define MBEDTLS_MULADDC_CORTEX_M7
+#endif
+
 /* For bignum */
 #define MBEDTLS_MPI_MAX_SIZE 512 /**< Maximum number of bytes for usable MPIs. 2048-bit RSA = 256 bytes */
 
@@ -0,0 +1,78 @@
+#ifndef RING_BUFFER_H
+#define RING_BUFFER_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+/*
+ * Lock-free single-producer / single-consumer byte ring.
+ *
+ * head is only written by the producer, tail only by the consumer; both are
+ * free-running counters, so head - tail is the fill level and no slot is
+ * wasted. The capacity must be a power of two. Acquire/release ordering
+ * (GCC __atomic builtins) makes it safe between thread mode and an ISR on
+ * the board, and between two threads in the host build.
+ */
+
+typedef struct {
+    uint8_t *buf;
+    uint32_t size;            /* power of two */
+    uint32_t head;            /* total bytes written (producer) */
+    uint32_t tail;            /* total bytes read (consumer) */
+} ring_buffer_t;
+
+static inline void rb_init(ring_buffer_t *rb, uint8_t *storage, uint32_t size) {
+    rb->buf = storage;
+    rb->size = size;
+    rb->head = 0;
+    rb->tail = 0;
+}
+
+static inline uint32_t rb_used(const ring_buffer_t *rb) {
+    return __atomic_load_n(&rb->head, __ATOMIC_ACQUIRE) - __atomic_load_n(&rb->tail, __ATOMIC_ACQUIRE);
+}
+
+static inline uint32_t rb_free(const ring_buffer_t *rb) {
+    return rb->size - rb_used(rb);
+}
+
+/**
+ * @brief  Producer: copies up to len bytes in.
+ * @return Number of bytes actually written (less than len if full).
+ */
+static inline size_t rb_write(ring_buffer_t *rb, const uint8_t *data, size_t len) {
+    uint32_t head = rb->head;
+    uint32_t tail = __atomic_load_n(&rb->tail, __ATOMIC_ACQUIRE);
+    uint32_t space = rb->size - (head - tail);
+    size_t n = len < space ? len : space;
+
+    for (size_t i = 0; i < n; i++) {
+        rb->buf[(head + i) & (rb->size - 1)] = data[i];
+    }
+    __atomic_store_n(&rb->head, head + (uint32_t)n, __ATOMIC_RELEASE);
+    return n;
+}
+
+/**
+ * @brief  Consumer: returns the longest contiguous readable run.
+ * @param  len Out: its length (0 if empty).
+ */
+static inline const uint8_t *rb_peek(const ring_buffer_t *rb, size_t *len) {
+    uint32_t head = __atomic_load_n(&rb->head, __ATOMIC_ACQUIRE);
+    uint32_t tail = rb->tail;
+    uint32_t idx = tail & (rb->size - 1);
+    uint32_t avail = head - tail;
+    uint32_t to_end = rb->size - idx;
+
+    *len = avail < to_end ? avail : to_end;
+    return &rb->buf[idx];
+}
+
+/**
+ * @brief  Consumer: releases n bytes obtained from rb_peek().
+ */
+static inline void rb_consume(ring_buffer_t *rb, size_t n) {
+    __atomic_store_n(&rb->tail, rb->tail + (uint32_t)n, __ATOMIC_RELEASE);
+}
+
+#endif /* RING_BUFFER_H */
@@ -0,0 +1,38 @@
+#ifndef RSA_KEYSTORE_H
+#define RSA_KEYSTORE_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include "mbedtls/rsa.h"
+
+/**
+ * @brief  One pre-generated RSA key in flash: raw big-endian integers, as
+ *         taken by mbedtls_rsa_import_raw().
+ */
+typedef struct {
+    int bits;
+    const uint8_t *n;
+    size_t n_len;
+    const uint8_t *p;
+    size_t p_len;
+    const uint8_t *q;
+    size_t q_len;
+    const uint8_t *d;
+    size_t d_len;
+    const uint8_t *e;
+    size_t e_len;
+} rsa_keystore_entry_t;
+
+/* Written at build time by scripts/gen_rsa_keystore.py (fixed seed) */
+extern const rsa_keystore_entry_t rsa_keystore[];
+extern const size_t rsa_keystore_count;
+
+/**
+ * @brief  Imports the stored key of the given size into an initialised
+ *         context and derives the CRT parameters (mbedtls_rsa_complete()).
+ * @return 0 on success, MBEDTLS_ERR_RSA_BAD_INPUT_DATA if no key of that
+ *         size is stored, or an mbedTLS error.
+ */
+int rsa_keystore_load(mbedtls_rsa_context *rsa, int bits);
+
+#endif /* RSA_KEYSTORE_H */
@@ -16,4 +16,19 @@ void stack_watermark_init(void);
  */
 size_t stack_watermark_get_usage(void);
 
+/**
+ * @brief  Function measured by stack_watermark_measure().
+ */
+typedef void (*stack_watermark_fn_t)(void *arg);
+
+/**
+ * @brief  Runs fn(arg) and returns its peak stack usage.
+ *         On the board this brackets the call with init/get_usage on the
+ *         main stack; the host build runs fn on a freshly painted stack.
+ * @param  fn  Function to run.
+ * @param  arg Argument passed to fn.
+ * @return Number of bytes used on the stack.
+ */
+size_t stack_watermark_measure(stack_watermark_fn_t fn, void *arg);
+
 #endif /* STACK_WATERMARK_H */
@@ -0,0 +1,109 @@
+#ifndef TELEMETRY_H
+#define TELEMETRY_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+/*
+ * Binary benchmark records, an alternative to the "UART >> ..." text lines.
+ *
+ * Frame on the wire:  0x00 | COBS(payload | crc16) | 0x00
+ * Payload (little-endian, TELEMETRY_PAYLOAD_LEN bytes):
+ *   u8  version     TELEMETRY_VERSION
+ *   u8  alg_id      telemetry_alg_t
+ *   u8  op_id       telemetry_op_t
+ *   u8  flags       TELEMETRY_FLAG_*
+ *   u16 iteration   measured run index (0-based)
+ *   u64 cycles      cycle count (error code if TELEMETRY_FLAG_FAILED)
+ *   u32 stack       peak stack bytes
+ *   u32 heap        peak heap bytes
+ *   u16 allocs      heap allocations during the op (saturating)
+ *   u16 frees       heap frees during the op (saturating)
+ *   u32 alloc_cycles cycles spent in the allocator during the op
+ *   u32 alloc_worst  slowest single allocator call during the op
+ * crc16 is CRC-16/CCITT-FALSE over the payload, little-endian.
+ *
+ * scripts/telemetry.py decodes this format; keep the two in sync.
+ */
+
+#define TELEMETRY_VERSION      3
+#define TELEMETRY_PAYLOAD_LEN  34
+/* payload + crc, plus COBS overhead byte and both delimiters */
+#define TELEMETRY_FRAME_MAX    (TELEMETRY_PAYLOAD_LEN + 2 + 1 + 2)
+
+typedef enum {
+    TELEMETRY_ALG_MLDSA44    = 1,
+    TELEMETRY_ALG_MLKEM512   = 2,
+    TELEMETRY_ALG_FALCON512  = 3,
+    TELEMETRY_ALG_SPHINCS    = 4,
+    TELEMETRY_ALG_RSA2048    = 5,
+    TELEMETRY_ALG_RSA3072    = 6,
+    TELEMETRY_ALG_RSA4096    = 7,
+    TELEMETRY_ALG_BIGINT2048 = 8,   /* custom RSA/Src BigInt */
+    TELEMETRY_ALG_BIGINT3072 = 9,
+    TELEMETRY_ALG_BIGINT4096 = 10,
+} telemetry_alg_t;
+
+typedef enum {
+    TELEMETRY_OP_KEYGEN      = 1,
+    TELEMETRY_OP_SIGN        = 2,
+    TELEMETRY_OP_VERIFY      = 3,
+    TELEMETRY_OP_ENCAPS      = 4,
+    TELEMETRY_OP_DECAPS      = 5,
+    TELEMETRY_OP_PUBLIC      = 6,
+    TELEMETRY_OP_PRIVATE     = 7,
+    TELEMETRY_OP_PUBLIC_REF  = 8,   /* reference (bit-serial) implementation */
+    TELEMETRY_OP_PRIVATE_VT  = 9,   /* variable-time private exponentiation */
+    TELEMETRY_OP_MUL         = 10,  /* full-width BigInt product */
+    TELEMETRY_OP_MUL_SWEEP   = 11,  /* schoolbook/Karatsuba crossover sweep */
+    TELEMETRY_OP_PRIVATE_CRT = 12,  /* private op with the CRT */
+    TELEMETRY_OP_MONT_ONCE   = 13,  /* public op, Montgomery context built per call */
+    TELEMETRY_OP_BARR_ONCE   = 14,  /* public op, Barrett context built per call */
+    TELEMETRY_OP_MONT_KEYED  = 15,  /* public op, Montgomery context reused */
+    TELEMETRY_OP_BARR_KEYED  = 16,  /* public op, Barrett context reused */
+    TELEMETRY_OP_KEYGEN_STOCK = 17, /* RSA keygen, stock mbedTLS prime search */
+    TELEMETRY_OP_PRIVATE_SLICED = 18, /* restartable private op, all slices */
+    TELEMETRY_OP_PUBLIC_ARENA = 19,   /* RSA public op, arena allocator */
+    TELEMETRY_OP_PRIVATE_ARENA = 20,  /* RSA private op, arena allocator */
+    TELEMETRY_OP_PUBLIC_BUFFER = 21,  /* RSA public op, mbedtls_memory_buffer_alloc */
+    TELEMETRY_OP_PRIVATE_BUFFER = 22, /* RSA private op, mbedtls_memory_buffer_alloc */
+} telemetry_op_t;
+
+#define TELEMETRY_FLAG_FAILED  0x01
+#define TELEMETRY_FLAG_COLD    0x02   /* caches cleaned+invalidated before the op */
+#define TELEMETRY_FLAG_CHECK   0x04   /* with FAILED: op returned 0 but its result was wrong */
+
+typedef struct {
+    uint8_t  alg_id;
+    uint8_t  op_id;
+    uint8_t  flags;
+    uint16_t iteration;
+    uint64_t cycles;
+    uint32_t stack;
+    uint32_t heap;
+    uint16_t allocs;
+    uint16_t frees;
+    uint32_t alloc_cycles;
+    uint32_t alloc_worst;
+} telemetry_record_t;
+
+/**
+ * @brief  CRC-16/CCITT-FALSE (poly 0x1021, init 0xFFFF).
+ */
+uint16_t telemetry_crc16(const uint8_t *data, size_t len);
+
+/**
+ * @brief  COBS-encodes a buffer (no delimiter is appended).
+ * @param  out Must hold len + len/254 + 1 bytes.
+ * @return Encoded length.
+ */
+size_t telemetry_cobs_encode(const uint8_t *in, size_t len, uint8_t *out);
+
+/**
+ * @brief  Serializes a record into a complete delimited frame.
+ * @param  out At least TELEMETRY_FRAME_MAX bytes.
+ * @return Frame length in bytes.
+ */
+size_t telemetry_encode(const telemetry_record_t *rec, uint8_t *out);
+
+#endif /* TELEMETRY_H */
@@ -0,0 +1,59 @@
+#ifndef TLSF_ALLOC_H
+#define TLSF_ALLOC_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+/*
+ * Two-level segregated fit allocator (Masmano et al., ECRTS 2004).
+ * Free blocks sit in 2^TLSF_SL_LOG2 lists per power of two; two bitmap
+ * lookups find a fitting list, so malloc and free run in constant time
+ * independent of the number of blocks. Blocks are 8-byte aligned.
+ *
+ * With PQC_HEAP_TLSF the firmware routes malloc/calloc/realloc/free (and
+ * the newlib _r variants) here, over the ._user_heap region of the linker
+ * script; pqc_demo_host puts it behind heap_stats instead.
+ */
+
+/* Second-level lists per power of two */
+#ifndef TLSF_SL_LOG2
+#define TLSF_SL_LOG2 4
+#endif
+
+/* Largest block: 2^TLSF_FL_MAX bytes */
+#ifndef TLSF_FL_MAX
+#define TLSF_FL_MAX 24
+#endif
+
+/**
+ * @brief  State of the pool (tlsf_get_stats()).
+ */
+typedef struct {
+    size_t size;                /* pool bytes, headers included */
+    size_t used;                /* payload bytes of allocated blocks */
+    size_t free;                /* payload bytes of free blocks */
+    size_t largest_free;        /* largest free block */
+    uint32_t free_blocks;
+    uint32_t frag_permille;     /* 1000 * (1 - largest_free / free) */
+    uint32_t worst_malloc;      /* slowest tlsf_malloc() since init, cycles */
+    uint32_t worst_free;        /* slowest tlsf_free() since init, cycles */
+} tlsf_stats_t;
+
+/**
+ * @brief  Turns a memory region into the pool, discarding any previous one.
+ * @return 0, or -1 if the region is too small or too large.
+ */
+int tlsf_alloc_init(void *mem, size_t size);
+
+void *tlsf_malloc(size_t size);
+void *tlsf_calloc(size_t n, size_t size);
+void *tlsf_realloc(void *ptr, size_t size);
+void tlsf_free(void *ptr);
+
+/**
+ * @brief  Walks the pool for used/free/largest free block; O(blocks),
+ *         for reporting outside measured regions.
+ */
+void tlsf_get_stats(tlsf_stats_t *out);
+
+#endif /* TLSF_ALLOC_H */
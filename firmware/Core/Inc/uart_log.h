@@ -0,0 +1,36 @@
+#ifndef UART_LOG_H
+#define UART_LOG_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+/* Ring capacity in bytes (power of two) */
+#ifndef UART_LOG_BUFFER_SIZE
+#define UART_LOG_BUFFER_SIZE 2048
+#endif
+
+/**
+ * @brief  Starts the non-blocking log on USART1 (huart1 must be initialized).
+ *         Output is queued in a ring buffer and drained by the TX interrupt.
+ */
+void uart_log_init(void);
+
+/**
+ * @brief  Queues bytes for transmission. Thread mode only (single producer).
+ *         Blocks only while the ring is full.
+ */
+void uart_log_write(const uint8_t *data, size_t len);
+
+/**
+ * @brief  Queues a NUL-terminated string.
+ */
+void uart_log_puts(const char *s);
+
+/**
+ * @brief  Flush barrier: returns once every queued byte has left the UART.
+ *         The harness calls this before each measured region so no TX
+ *         interrupt fires inside it.
+ */
+void uart_log_flush(void);
+
+#endif /* UART_LOG_H */
@@ -0,0 +1,96 @@
+/**
+ * arena_alloc.c - Bump allocator for mbedTLS temporaries
+ * Blocks are handed out from the top of one buffer; each carries an 8-byte
+ * header linking it to the block below, so a free of the top block (the
+ * usual order for bignum temporaries) lowers the top again. Whatever is
+ * left goes at once in arena_reset().
+ */
+#include "arena_alloc.h"
+#include <string.h>
+
+#define ARENA_NONE  UINT32_MAX
+#define ARENA_ALIGN 8u
+
+typedef union {
+    struct {
+        uint32_t prev;  /* offset of the block below, ARENA_NONE for the first */
+        uint32_t live;  /* cleared by arena_free() */
+    } h;
+    uint64_t align;
+} arena_hdr_t;
+
+static uint8_t *arena_buf;
+static size_t arena_size;
+static size_t arena_top;        /* first free byte */
+static uint32_t arena_last;     /* offset of the top block, ARENA_NONE if empty */
+static size_t arena_peak;
+static uint32_t arena_failed;
+
+void arena_alloc_init(void *buf, size_t size) {
+    arena_buf = (uint8_t *)buf;
+    arena_size = size;
+    arena_peak = 0;
+    arena_failed = 0;
+    arena_reset();
+}
+
+void *arena_calloc(size_t n, size_t size) {
+    arena_hdr_t *hdr;
+    size_t bytes;
+
+    if (size != 0 && n > (arena_size - arena_top) / size) {
+        arena_failed++;
+        return NULL;
+    }
+    bytes = (n * size + ARENA_ALIGN - 1) & ~(size_t)(ARENA_ALIGN - 1);
+    if (bytes + sizeof(arena_hdr_t) > arena_size - arena_top) {
+        arena_failed++;
+        return NULL;
+    }
+
+    hdr = (arena_hdr_t *)(arena_buf + arena_top);
+    hdr->h.prev = arena_last;
+    hdr->h.live = 1;
+    arena_last = (uint32_t)arena_top;
+    arena_top += sizeof(arena_hdr_t) + bytes;
+    if (arena_top > arena_peak) {
+        arena_peak = arena_top;
+    }
+    memset(hdr + 1, 0, bytes);
+    return hdr + 1;
+}
+
+void arena_free(void *ptr) {
+    arena_hdr_t *hdr;
+
+    if (ptr == NULL) {
+        return;
+    }
+    ((arena_hdr_t *)ptr - 1)->h.live = 0;
+
+    /* Pop the top block and every freed one directly below it */
+    while (arena_last != ARENA_NONE) {
+        hdr = (arena_hdr_t *)(arena_buf + arena_last);
+        if (hdr->h.live) {
+            break;
+        }
+        arena_top = arena_last;
+        arena_last = hdr->h.prev;
+    }
+}
+
+void arena_reset(void) {
+    arena_top = 0;
+    arena_last = ARENA_NONE;
+}
+
+void arena_reset_peak(void) {
+    arena_peak = arena_top;
+}
+
+void arena_get(arena_stats_t *out) {
+    out->size = arena_size;
+    out->used = arena_top;
+    out->peak = arena_peak;
+    out->failed = arena_failed;
+}
@@ -0,0 +1,53 @@
+#include "bench_stats.h"
+#include <math.h>
+#include <string.h>
+
+/* Insertion sort: n is at most BENCH_MAX_SAMPLES, no need for qsort */
+static void sort_u64(uint64_t *v, uint32_t n) {
+    for (uint32_t i = 1; i < n; i++) {
+        uint64_t x = v[i];
+        uint32_t j = i;
+        while (j > 0 && v[j - 1] > x) {
+            v[j] = v[j - 1];
+            j--;
+        }
+        v[j] = x;
+    }
+}
+
+void bench_stats_compute(uint64_t *samples, uint32_t n, bench_stats_t *out) {
+    memset(out, 0, sizeof(*out));
+    out->n = n;
+    if (n == 0) {
+        return;
+    }
+
+    sort_u64(samples, n);
+    out->min = samples[0];
+    out->max = samples[n - 1];
+
+    if (n % 2) {
+        out->median = samples[n / 2];
+    } else {
+        out->median = samples[n / 2 - 1] + (samples[n / 2] - samples[n / 2 - 1]) / 2;
+    }
+
+    /* Nearest-rank percentile: smallest sample with >= 90% at or below it */
+    uint32_t rank = (n * 90 + 99) / 100;
+    out->p90 = samples[rank - 1];
+
+    /* Cycle counts reach 2^40 and beyond, so accumulate in double */
+    double sum = 0.0;
+    for (uint32_t i = 0; i < n; i++) {
+        sum += (double)samples[i];
+    }
+    double mean = sum / n;
+    double var = 0.0;
+    for (uint32_t i = 0; i < n; i++) {
+        double d = (double)samples[i] - mean;
+        var += d * d;
+    }
+    /* Sample standard deviation (n - 1), 0 for a single run */
+    out->mean = (uint64_t)(mean + 0.5);
+    out->stddev = (n > 1) ? (uint64_t)(sqrt(var / (n - 1)) + 0.5) : 0;
+}
@@ -1,13 +1,23 @@
 #include "crypto_harness.h"
 #include "cycles.h"
 #include "stack_watermark.h"
+#include "bench_stats.h"
+#include "telemetry.h"
+#include "heap_stats.h"
+#include "arena_alloc.h"
+#include "tlsf_alloc.h"
+#include "uart_log.h"
 #include "stm32f7xx_hal.h"
 #include <stdio.h>
+#include <stdlib.h>
 #include <string.h>
 
 /* Crypto includes */
 #include "mbedtls/rsa.h"
 #include "mbedtls/platform.h"
+#include "mbedtls/memory_buffer_alloc.h"
+#include "rsa.h"
+#include "rsa_keystore.h"
 
 // NIST Round 3 PQC Candidates (PQClean for Falcon/Sphincs)
 #include "deps/PQClean/crypto_sign/falcon-512/clean/api.h"
@@ -31,8 +41,10 @@ int crypto_kem_dec(uint8_t *ss, const uint8_t *ct, const uint8_t *sk);
 int crypto_sign_keypair(uint8_t *pk, uint8_t *sk);
 int crypto_sign_signature(uint8_t *sig, size_t *siglen, const uint8_t *m, size_t mlen, const uint8_t *sk);
 int crypto_sign_verify(const uint8_t *sig, size_t siglen, const uint8_t *m, size_t mlen, const uint8_t *pk);
+// Note: pqm4/api.h defines crypto_sign_signature as a macro calling _ctx with NULL, 0.
+// Since we don't include that api.h, we call _ctx directly.
+int crypto_sign_signature_ctx(uint8_t *sig, size_t *siglen, const uint8_t *m, size_t mlen, const uint8_t *ctx, size_t ctxlen, const uint8_t *sk);
 
-extern UART_HandleTypeDef huart1;
 
 /* Static buffers to avoid stack overflow for very large items. */
 static uint8_t pk[4096];
@@ -41,230 +53,1298 @@ static uint8_t sig[20480]; // Increased to 20KB for SPHINCS+ signatures
 static uint8_t ct[2048];
 static uint8_t ss1[128];
 static uint8_t ss2[128];
+static size_t siglen;
+
+/* RSA state shared by the KeyGen/Public/Private descriptors of one key size */
+static mbedtls_rsa_context rsa;
+static unsigned char rsa_input[512]; // Up to 4096 bits = 512 bytes
+static unsigned char rsa_output[512];
+static unsigned char rsa_output_dec[512];
+
+/* Custom BigInt RSA (RSA/Src), run on the public key exported from rsa */
+static BigInt bi_n, bi_e, bi_d, bi_m, bi_c, bi_r;
+static rsa_private_key bi_key;
+static bi_mod_ctx bi_red;             /* reduction context for the modexp entries */
+
+static const uint8_t bench_msg[] = "test";
+#define BENCH_MSG_LEN 4
+
+/* ------------------------------------------------------------------
+ * Benchmark registry
+ * ----------------------------------------------------------------*/
+
+/* Measured iterations and unrecorded warm-up runs per operation.
+ * Multi-second operations use the SLOW count so a full run stays practical. */
+#ifndef BENCH_ITERATIONS
+#define BENCH_ITERATIONS 10
+#endif
+#ifndef BENCH_WARMUP
+#define BENCH_WARMUP 1
+#endif
+#ifndef BENCH_ITERATIONS_SLOW
+#define BENCH_ITERATIONS_SLOW 3
+#endif
+
+/* Cache state at the start of each measured run (bench_desc.cache_modes).
+ * COLD cleans and invalidates the I/D-caches right before the op (crypto
+ * after a long idle period); WARM follows the warm-up pre-run(s). */
+#define BENCH_CACHE_COLD 0x01
+#define BENCH_CACHE_WARM 0x02
+#define BENCH_CACHE_BOTH (BENCH_CACHE_COLD | BENCH_CACHE_WARM)
+
+/* Cache fill is noise next to multi-second ops, so SLOW entries run warm only.
+ * These leave bench_desc.metric unset; entries with one spell out the runs. */
+#define BENCH_REPEAT_DEFAULT BENCH_ITERATIONS, BENCH_WARMUP, BENCH_CACHE_BOTH, NULL, NULL
+#define BENCH_REPEAT_SLOW    BENCH_ITERATIONS_SLOW, 0, BENCH_CACHE_WARM, NULL, NULL
+#define BENCH_REPEAT_ONCE    1, 0, BENCH_CACHE_WARM, NULL, NULL
+
+/* RSA_KEYGEN is opt-in: benchmark_rsa_keygen() or a full "<Alg> <Op>" name */
+typedef enum {
+    BENCH_SUITE_PQC,
+    BENCH_SUITE_RSA,
+    BENCH_SUITE_RSA_KEYGEN,
+} bench_suite_t;
+
+typedef struct bench_alg bench_alg_t;
+typedef struct bench_desc bench_desc_t;
+
+/* One algorithm (parameter set); owns the key material in pk/sk or rsa */
+struct bench_alg {
+    const char *name;                          /* record prefix, e.g. "ML-KEM-512" */
+    const char *banner;                        /* section header text */
+    int bits;                                  /* RSA modulus size, 0 for PQC */
+    int (*keypair)(const bench_alg_t *alg);    /* fills pk/sk (or rsa) */
+    int (*sign)(void);                         /* sk, bench_msg -> sig/siglen */
+    int (*verify)(void);                       /* sig/siglen, bench_msg, pk -> 0 if valid */
+    int (*encaps)(void);                       /* pk -> ct, ss1 */
+    int (*decaps)(void);                       /* ct, sk -> ss2 */
+    telemetry_alg_t id;                        /* binary record algorithm ID */
+};
+
+/* One measured operation of an algorithm */
+struct bench_desc {
+    const bench_alg_t *alg;
+    const char *op;                                  /* e.g. "Encaps" */
+    telemetry_op_t op_id;                            /* binary record operation ID */
+    bench_suite_t suite;
+    int  (*setup)(const bench_desc_t *d);            /* unmeasured, before op */
+    int  (*run)(const bench_desc_t *d);              /* measured region */
+    void (*teardown)(const bench_desc_t *d, int ret);/* unmeasured, after op */
+    int  (*check)(const bench_desc_t *d);            /* unmeasured result check, 0 if correct */
+    size_t pk_bytes;                                 /* buffer requirements */
+    size_t sk_bytes;
+    size_t sig_bytes;
+    size_t ct_bytes;
+    size_t ss_bytes;
+    uint16_t iterations;                             /* measured runs */
+    uint16_t warmup;                                 /* unrecorded runs first (warm mode) */
+    uint8_t cache_modes;                             /* BENCH_CACHE_* */
+    uint32_t (*metric)(const bench_desc_t *d);       /* extra figure of a run, read before check */
+    const char *metric_fmt;                          /* its text line, one %lu (highest of the runs) */
+};
+
+/* Algorithm whose keys currently live in pk/sk/rsa (NULL if none) */
+static const bench_alg_t *key_owner;
+
+/* Algorithm whose verified signature of bench_msg is in sig (NULL if none) */
+static const bench_alg_t *sig_owner;
+
+/* Compiler flags of this image, set per target by CMakeLists.txt */
+#ifndef PQC_BUILD_PROFILE
+#define PQC_BUILD_PROFILE "unknown"
+#endif
+
+/* Returned by bench_measure() when the op succeeded but its result is wrong
+ * (outside the mbedTLS error code range) */
+#define BENCH_ERR_CHECK (-0x7FFF)
+
+static void uart_puts(const char *s) {
+    uart_log_puts(s);
+}
+
+/* newlib-nano printf has no %llu, so 64-bit cycle counts are formatted by hand */
+static char *u64_to_str(char *out, uint64_t v) {
+    char tmp[21];
+    int n = 0;
+    do {
+        tmp[n++] = (char)('0' + (v % 10));
+        v /= 10;
+    } while (v != 0);
+    for (int i = 0; i < n; i++) {
+        out[i] = tmp[n - 1 - i];
+    }
+    out[n] = '\0';
+    return out;
+}
+
+/* Simple LCG for deterministic benchmarking without HW RNG dependence.
+ * RSA key generation restarts it from BENCH_RNG_SEED (see setup_keygen). */
+#ifndef BENCH_RNG_SEED
+#define BENCH_RNG_SEED 0x12345678
+#endif
+static uint32_t fake_rng_seed = BENCH_RNG_SEED;
 
-/* Simple LCG for deterministic benchmarking without HW RNG dependence */
 static int fake_rng(void *p_rng, unsigned char *output, size_t output_len) {
-    static uint32_t seed = 0x12345678;
+    (void)p_rng;
     for(size_t i = 0; i < output_len; i++) {
-        seed = seed * 1664525 + 1013904223;
-        output[i] = (unsigned char)(seed >> 24);
+        fake_rng_seed = fake_rng_seed * 1664525 + 1013904223;
+        output[i] = (unsigned char)(fake_rng_seed >> 24);
     }
     return 0;
 }
 
-void benchmark_rsa_suite(void) {
-    uint32_t start, end;
-    size_t stack_used;
-    char buf[128];
-    mbedtls_rsa_context rsa;
-    unsigned char input[512]; // Up to 4096 bits = 512 bytes
-    unsigned char output[512];
-    unsigned char output_dec[512];
+/* --- Key generation (shared by the Keygen op and dependent setups) --- */
+
+static int keypair_mlkem512(const bench_alg_t *alg) {
+    (void)alg;
+    return crypto_kem_keypair(pk, sk);
+}
+
+static int keypair_mldsa44(const bench_alg_t *alg) {
+    (void)alg;
+    return crypto_sign_keypair(pk, sk);
+}
+
+static int keypair_falcon512(const bench_alg_t *alg) {
+    (void)alg;
+    return PQCLEAN_FALCON512_CLEAN_crypto_sign_keypair(pk, sk);
+}
+
+static int keypair_sphincs(const bench_alg_t *alg) {
+    (void)alg;
+    return PQCLEAN_SPHINCSSHA2128SSIMPLE_CLEAN_crypto_sign_keypair(pk, sk);
+}
+
+/* RSA keys for the public/private ops come from the flash key store;
+ * generating them is the (opt-in) KeyGen benchmark, op_rsa_keygen() */
+static int keypair_rsa(const bench_alg_t *alg) {
+    return rsa_keystore_load(&rsa, alg->bits);
+}
+
+/* mbedtls_mpi -> BigInt, through rsa_output_dec as byte scratch */
+static int bigint_from_mpi(BigInt *a, const mbedtls_mpi *x) {
+    size_t len = mbedtls_mpi_size(x);
+    int ret = mbedtls_mpi_write_binary(x, rsa_output_dec, len);
+    if (ret == 0) {
+        bi_from_bytes(a, rsa_output_dec, (int)len);
+    }
+    return ret;
+}
+
+/* mbedTLS generates the key; the custom BigInt code gets N, E, D and the
+ * CRT parameters */
+static int keypair_bigint(const bench_alg_t *alg) {
     int ret;
-    int key_sizes[] = {2048, 3072, 4096};
+    size_t len = (size_t)alg->bits / 8;
+    mbedtls_mpi p, q, dp, dq, qp;
 
-    sprintf(buf, "\r\n=== RSA Scalability Suite (2048, 3072, 4096) ===\r\n");
-    HAL_UART_Transmit(&huart1, (uint8_t*)buf, strlen(buf), 1000);
+    if (alg->bits > BI_MAX_WORDS * 32) {
+        return MBEDTLS_ERR_RSA_BAD_INPUT_DATA;
+    }
+    ret = keypair_rsa(alg);
+    if (ret == 0) {
+        ret = mbedtls_rsa_export_raw(&rsa, rsa_output, len, NULL, 0, NULL, 0,
+                                     rsa_input, len, rsa_output_dec, len);
+    }
+    if (ret != 0) {
+        return ret;
+    }
+    bi_from_bytes(&bi_n, rsa_output, (int)len);
+    bi_from_bytes(&bi_d, rsa_input, (int)len);
+    bi_from_bytes(&bi_e, rsa_output_dec, (int)len);
+    bi_copy(&bi_key.n, &bi_n);
 
-    for (int i = 0; i < 3; i++) {
-        int bits = key_sizes[i];
-        sprintf(buf, "\r\n--- RSA-%d ---\r\n", bits);
-        HAL_UART_Transmit(&huart1, (uint8_t*)buf, strlen(buf), 1000);
+    mbedtls_mpi_init(&p);
+    mbedtls_mpi_init(&q);
+    mbedtls_mpi_init(&dp);
+    mbedtls_mpi_init(&dq);
+    mbedtls_mpi_init(&qp);
+    ret = mbedtls_rsa_export(&rsa, NULL, &p, &q, NULL, NULL);
+    if (ret == 0) {
+        ret = mbedtls_rsa_export_crt(&rsa, &dp, &dq, &qp);
+    }
+    if (ret == 0) ret = bigint_from_mpi(&bi_key.p, &p);
+    if (ret == 0) ret = bigint_from_mpi(&bi_key.q, &q);
+    if (ret == 0) ret = bigint_from_mpi(&bi_key.dp, &dp);
+    if (ret == 0) ret = bigint_from_mpi(&bi_key.dq, &dq);
+    if (ret == 0) ret = bigint_from_mpi(&bi_key.qinv, &qp);
+    mbedtls_mpi_free(&p);
+    mbedtls_mpi_free(&q);
+    mbedtls_mpi_free(&dp);
+    mbedtls_mpi_free(&dq);
+    mbedtls_mpi_free(&qp);
+    return ret;
+}
 
+/* --- Per-algorithm primitives on the shared buffers --- */
+
+static int mlkem512_encaps(void) {
+    return crypto_kem_enc(ct, ss1, pk);
+}
+
+static int mlkem512_decaps(void) {
+    return crypto_kem_dec(ss2, ct, sk);
+}
+
+static int mldsa44_sign(void) {
+    return crypto_sign_signature_ctx(sig, &siglen, bench_msg, BENCH_MSG_LEN, NULL, 0, sk);
+}
+
+static int mldsa44_verify(void) {
+    return crypto_sign_verify(sig, siglen, bench_msg, BENCH_MSG_LEN, pk);
+}
+
+static int falcon512_sign(void) {
+    return PQCLEAN_FALCON512_CLEAN_crypto_sign_signature(sig, &siglen, bench_msg, BENCH_MSG_LEN, sk);
+}
+
+static int falcon512_verify(void) {
+    return PQCLEAN_FALCON512_CLEAN_crypto_sign_verify(sig, siglen, bench_msg, BENCH_MSG_LEN, pk);
+}
+
+static int sphincs_sign(void) {
+    return PQCLEAN_SPHINCSSHA2128SSIMPLE_CLEAN_crypto_sign_signature(sig, &siglen, bench_msg, BENCH_MSG_LEN, sk);
+}
+
+static int sphincs_verify(void) {
+    return PQCLEAN_SPHINCSSHA2128SSIMPLE_CLEAN_crypto_sign_verify(sig, siglen, bench_msg, BENCH_MSG_LEN, pk);
+}
+
+/* --- Setup / teardown helpers --- */
+
+/* Keygen is about to overwrite the key slot */
+static int setup_keygen(const bench_desc_t *d) {
+    key_owner = NULL;
+    sig_owner = NULL;
+    if (d->alg->bits != 0) {
+        mbedtls_rsa_free(&rsa);
         mbedtls_rsa_init(&rsa);
         mbedtls_rsa_set_padding(&rsa, MBEDTLS_RSA_PKCS_V15, MBEDTLS_MD_SHA256);
+        /* Prime search time depends on the random stream: every run draws
+         * the same one, so runs (and the sieve/stock entries) compare */
+        fake_rng_seed = BENCH_RNG_SEED;
+    }
+    return 0;
+}
+
+static void teardown_keygen(const bench_desc_t *d, int ret) {
+    if (ret == 0) {
+        key_owner = d->alg;
+    }
+}
+
+#if defined(MBEDTLS_GENPRIME_SIEVE)
+/* RSA KeyGen with the stock mbedtls_mpi_gen_prime() candidate search */
+static int setup_keygen_stock(const bench_desc_t *d) {
+    mbedtls_mpi_gen_prime_set_sieve(0);
+    return setup_keygen(d);
+}
+
+static void teardown_keygen_stock(const bench_desc_t *d, int ret) {
+    mbedtls_mpi_gen_prime_set_sieve(1);
+    teardown_keygen(d, ret);
+}
+#endif
+
+/* Dependent ops need the algorithm's keys; generate them unmeasured if absent */
+static int setup_need_keys(const bench_desc_t *d) {
+    int ret;
+    if (key_owner == d->alg) {
+        return 0;
+    }
+    setup_keygen(d);
+    ret = d->alg->keypair(d->alg);
+    teardown_keygen(d, ret);
+    return ret;
+}
+
+/* Sign overwrites sig, which only becomes valid again once checked */
+static int setup_sign(const bench_desc_t *d) {
+    sig_owner = NULL;
+    return setup_need_keys(d);
+}
+
+/* Verify needs a valid signature; signing is slow for SPHINCS+, so reuse one */
+static int setup_verify(const bench_desc_t *d) {
+    int ret = setup_need_keys(d);
+    if (ret != 0 || sig_owner == d->alg) {
+        return ret;
+    }
+    ret = d->alg->sign();
+    if (ret == 0 && d->alg->verify() == 0) {
+        sig_owner = d->alg;
+    }
+    return ret;
+}
+
+static int setup_decaps(const bench_desc_t *d) {
+    int ret = setup_need_keys(d);
+    if (ret != 0) {
+        return ret;
+    }
+    memset(ss2, 0, sizeof(ss2));
+    return d->alg->encaps();
+}
+
+static int setup_rsa_public(const bench_desc_t *d) {
+    int ret = setup_need_keys(d);
+    // Use a smaller input size that fits in all moduli
+    memset(rsa_input, 0xAA, 200); // 200 bytes fits in 2048 bits (256 bytes)
+    rsa_input[199] = 0;
+    rsa_input[0] = 0;             // big-endian: keep the value below any modulus N
+    return ret;
+}
+
+/* The private op decrypts the output of a (unmeasured) public op */
+static int setup_rsa_private(const bench_desc_t *d) {
+    int ret = setup_rsa_public(d);
+    if (ret != 0) {
+        return ret;
+    }
+    memset(rsa_output_dec, 0, sizeof(rsa_output_dec));
+    return mbedtls_rsa_public(&rsa, rsa_input, rsa_output);
+}
+
+/* Full-width product of two key-sized values, N * D */
+static int setup_bigint_mul(const bench_desc_t *d) {
+    int ret = setup_need_keys(d);
+    bi_set_uint32(&bi_r, 0);
+    return ret;
+}
+
+static int setup_bigint_public(const bench_desc_t *d) {
+    int ret = setup_rsa_public(d);
+    bi_from_bytes(&bi_m, rsa_input, (int)mbedtls_rsa_get_len(&rsa));
+    bi_set_uint32(&bi_r, 0);
+    return ret;
+}
+
+/* Keyed entries reuse a context prepared here; one-shot entries rebuild it */
+static int setup_bigint_mont(const bench_desc_t *d) {
+    int ret = setup_bigint_public(d);
+    bi_mod_ctx_init(&bi_red, &bi_n, BI_REDUCE_MONTGOMERY);
+    return ret;
+}
+
+static int setup_bigint_barrett(const bench_desc_t *d) {
+    int ret = setup_bigint_public(d);
+    bi_mod_ctx_init(&bi_red, &bi_n, BI_REDUCE_BARRETT);
+    return ret;
+}
+
+/* Decrypts the mbedTLS encryption of the usual input */
+static int setup_bigint_private(const bench_desc_t *d) {
+    int ret = setup_rsa_private(d);
+    bi_from_bytes(&bi_m, rsa_input, (int)mbedtls_rsa_get_len(&rsa));
+    bi_from_bytes(&bi_c, rsa_output, (int)mbedtls_rsa_get_len(&rsa));
+    bi_set_uint32(&bi_r, 0);
+    return ret;
+}
+
+/* --- Result checks (unmeasured, run after every measured op) --- */
+
+/* sig must verify, and a tampered copy must not */
+static int check_signature(const bench_desc_t *d) {
+    int bad;
+    if (d->alg->verify() != 0) {
+        return -1;
+    }
+    sig[0] ^= 0x01;
+    bad = d->alg->verify();
+    sig[0] ^= 0x01;
+    if (bad == 0) {
+        return -1;
+    }
+    sig_owner = d->alg;
+    return 0;
+}
+
+/* ss2 must match ss1, and a tampered ciphertext must give a different secret */
+static int check_shared_secret(const bench_desc_t *d) {
+    int same;
+    if (memcmp(ss1, ss2, d->ss_bytes) != 0) {
+        return -1;
+    }
+    ct[0] ^= 0x01;
+    same = d->alg->decaps() == 0 && memcmp(ss1, ss2, d->ss_bytes) == 0;
+    ct[0] ^= 0x01;
+    return same ? -1 : 0;
+}
+
+static int check_encaps(const bench_desc_t *d) {
+    memset(ss2, 0, sizeof(ss2));
+    if (d->alg->decaps() != 0) {
+        return -1;
+    }
+    return check_shared_secret(d);
+}
+
+/* Fresh keys must complete a round trip. SPHINCS+ keys are left to its
+ * Sign entry: one extra signature would cost more than the keygen itself. */
+static int check_keys(const bench_desc_t *d) {
+    if (d->alg->encaps) {
+        return d->alg->encaps() != 0 ? -1 : check_encaps(d);
+    }
+    if (d->alg->sign() != 0) {
+        return -1;
+    }
+    return check_signature(d);
+}
+
+static int check_rsa_keys(const bench_desc_t *d) {
+    (void)d;
+    return mbedtls_rsa_check_privkey(&rsa);
+}
+
+/* The custom result must match mbedTLS for the same key and input */
+static int check_bigint_public(const bench_desc_t *d) {
+    size_t len = mbedtls_rsa_get_len(&rsa);
+    int ret = mbedtls_rsa_public(&rsa, rsa_input, rsa_output);
+    (void)d;
+    if (ret != 0) {
+        return ret;
+    }
+    bi_to_bytes(&bi_r, rsa_output_dec, (int)len);
+    return memcmp(rsa_output_dec, rsa_output, len) != 0 ? -1 : 0;
+}
+
+/* Karatsuba must match plain schoolbook */
+static int check_bigint_mul(const bench_desc_t *d) {
+    BigInt ref;
+    (void)d;
+    bi_mul_karatsuba(&ref, &bi_n, &bi_d, BI_MAX_WORDS + 1);
+    return bi_compare(&ref, &bi_r) != 0 ? -1 : 0;
+}
+
+static int check_bigint_private(const bench_desc_t *d) {
+    (void)d;
+    return bi_compare(&bi_m, &bi_r) != 0 ? -1 : 0;
+}
+
+/* Decryption must restore the public op input */
+static int check_rsa_private(const bench_desc_t *d) {
+    (void)d;
+    return memcmp(rsa_output_dec, rsa_input, mbedtls_rsa_get_len(&rsa)) != 0 ? -1 : 0;
+}
+
+/* The private op on the public op output must restore the input */
+static int check_rsa_public(const bench_desc_t *d) {
+    int ret = mbedtls_rsa_private(&rsa, fake_rng, NULL, rsa_output, rsa_output_dec);
+    if (ret != 0) {
+        return ret;
+    }
+    return check_rsa_private(d);
+}
+
+/* --- Measured operations --- */
+
+static int op_keypair(const bench_desc_t *d) {
+    return d->alg->keypair(d->alg);
+}
+
+static int op_sign(const bench_desc_t *d) {
+    return d->alg->sign();
+}
+
+static int op_verify(const bench_desc_t *d) {
+    return d->alg->verify();
+}
+
+static int op_encaps(const bench_desc_t *d) {
+    return d->alg->encaps();
+}
+
+static int op_decaps(const bench_desc_t *d) {
+    return d->alg->decaps();
+}
+
+static int op_rsa_keygen(const bench_desc_t *d) {
+    return mbedtls_rsa_gen_key(&rsa, fake_rng, NULL, d->alg->bits, 65537);
+}
+
+static int op_rsa_public(const bench_desc_t *d) {
+    (void)d;
+    return mbedtls_rsa_public(&rsa, rsa_input, rsa_output);
+}
+
+static int op_bigint_public(const bench_desc_t *d) {
+    (void)d;
+    rsa_public_op(&bi_r, &bi_m, &bi_e, &bi_n);
+    return 0;
+}
+
+static int op_bigint_public_ref(const bench_desc_t *d) {
+    (void)d;
+    bi_mod_exp_bitserial(&bi_r, &bi_m, &bi_e, &bi_n);
+    return 0;
+}
+
+static int op_bigint_private(const bench_desc_t *d) {
+    (void)d;
+    rsa_private_op(&bi_r, &bi_c, &bi_d, &bi_n);
+    return 0;
+}
+
+/* One-shot: the per-modulus precomputation is part of every call */
+static int op_bigint_mont_once(const bench_desc_t *d) {
+    (void)d;
+    bi_mod_ctx_init(&bi_red, &bi_n, BI_REDUCE_MONTGOMERY);
+    bi_mod_exp_ctx(&bi_r, &bi_m, &bi_e, &bi_red);
+    return 0;
+}
+
+static int op_bigint_barrett_once(const bench_desc_t *d) {
+    (void)d;
+    bi_mod_ctx_init(&bi_red, &bi_n, BI_REDUCE_BARRETT);
+    bi_mod_exp_ctx(&bi_r, &bi_m, &bi_e, &bi_red);
+    return 0;
+}
+
+/* Repeated key: the context from setup is reused */
+static int op_bigint_mod_keyed(const bench_desc_t *d) {
+    (void)d;
+    bi_mod_exp_ctx(&bi_r, &bi_m, &bi_e, &bi_red);
+    return 0;
+}
+
+static int op_bigint_mul(const bench_desc_t *d) {
+    (void)d;
+    bi_mul(&bi_r, &bi_n, &bi_d);
+    return 0;
+}
 
-        /* 1. Key Generation */
-        sprintf(buf, "UART >> RSA-%d: Starting KeyGen...\r\n", bits);
-        HAL_UART_Transmit(&huart1, (uint8_t*)buf, strlen(buf), 1000);
-        
-        stack_watermark_init();
-        cycles_reset();
-        start = cycles_get();
-        ret = mbedtls_rsa_gen_key(&rsa, fake_rng, NULL, bits, 65537);
-        end = cycles_get();
-        stack_used = stack_watermark_get_usage();
-
-        if(ret != 0) {
-            sprintf(buf, "UART >> RSA-%d: KeyGen Failed (-0x%04X)\r\n", bits, -ret);
-            HAL_UART_Transmit(&huart1, (uint8_t*)buf, strlen(buf), 1000);
-            mbedtls_rsa_free(&rsa);
-            continue;
+/* Karatsuba crossover: schoolbook vs. one Karatsuba level (threshold = n)
+ * for n-word operands cut from the key, n = STEP .. 2048 bits */
+#define MUL_SWEEP_STEP   4
+#define MUL_SWEEP_POINTS (BI_WORDS_2048 / MUL_SWEEP_STEP)
+#define MUL_SWEEP_RUNS   5
+static uint32_t mul_sweep_school[MUL_SWEEP_POINTS];
+static uint32_t mul_sweep_kara[MUL_SWEEP_POINTS];
+
+/* Best of MUL_SWEEP_RUNS; 32-bit samples are enough for one product */
+static uint32_t mul_sweep_cycles(const BigInt *a, const BigInt *b, int threshold) {
+    uint32_t best = UINT32_MAX;
+    for (int k = 0; k < MUL_SWEEP_RUNS; k++) {
+        uint32_t start = cycles_get();
+        bi_mul_karatsuba(&bi_r, a, b, threshold);
+        uint32_t t = cycles_get() - start;
+        if (t < best) {
+            best = t;
         }
+    }
+    return best;
+}
 
-        sprintf(buf, "UART >> RSA-%d: KeyGen took %lu cycles, Stack: %u bytes\r\n", bits, end - start, (unsigned int)stack_used);
-        HAL_UART_Transmit(&huart1, (uint8_t*)buf, strlen(buf), 1000);
-
-        /* 2. Public Key Operation (Encrypt) */
-        // Use a smaller input size that fits in all moduli
-        memset(input, 0xAA, 200); // 200 bytes fits in 2048 bits (256 bytes)
-        input[199] = 0; 
-
-        sprintf(buf, "UART >> RSA-%d: Starting Public Op...\r\n", bits);
-        HAL_UART_Transmit(&huart1, (uint8_t*)buf, strlen(buf), 1000);
-
-        stack_watermark_init();
-        cycles_reset();
-        start = cycles_get();
-        ret = mbedtls_rsa_public(&rsa, input, output);
-        end = cycles_get();
-        stack_used = stack_watermark_get_usage();
-
-        if(ret != 0) {
-            sprintf(buf, "UART >> RSA-%d: Public Op Failed (-0x%04X)\r\n", bits, -ret);
-            HAL_UART_Transmit(&huart1, (uint8_t*)buf, strlen(buf), 1000);
-            mbedtls_rsa_free(&rsa);
-            continue;
+static int op_bigint_mul_sweep(const bench_desc_t *d) {
+    (void)d;
+    for (int i = 0; i < MUL_SWEEP_POINTS; i++) {
+        int n = (i + 1) * MUL_SWEEP_STEP;
+        bi_copy(&bi_m, &bi_n);
+        bi_resize(&bi_m, n);
+        bi_copy(&bi_c, &bi_d);
+        bi_resize(&bi_c, n);
+        mul_sweep_school[i] = mul_sweep_cycles(&bi_m, &bi_c, BI_MAX_WORDS + 1);
+        mul_sweep_kara[i] = mul_sweep_cycles(&bi_m, &bi_c, n);
+    }
+    return 0;
+}
+
+/* Prints the sweep and the smallest size from which Karatsuba always wins */
+static void teardown_bigint_mul_sweep(const bench_desc_t *d, int ret) {
+    char buf[128];
+    int crossover = 0;
+
+    if (ret != 0) {
+        return;
+    }
+    for (int i = 0; i < MUL_SWEEP_POINTS; i++) {
+        sprintf(buf, "UART >> %s: Mul %d words: schoolbook %lu, Karatsuba %lu cycles\r\n", d->alg->name,
+                (i + 1) * MUL_SWEEP_STEP, (unsigned long)mul_sweep_school[i],
+                (unsigned long)mul_sweep_kara[i]);
+        uart_puts(buf);
+        if (mul_sweep_kara[i] >= mul_sweep_school[i]) {
+            crossover = 0;
+        } else if (crossover == 0) {
+            crossover = (i + 1) * MUL_SWEEP_STEP;
         }
+    }
+    if (crossover) {
+        sprintf(buf, "UART >> %s: Karatsuba crossover at %d words (BI_KARATSUBA_THRESHOLD = %d)\r\n",
+                d->alg->name, crossover, BI_KARATSUBA_THRESHOLD);
+    } else {
+        sprintf(buf, "UART >> %s: Karatsuba crossover above %d words (BI_KARATSUBA_THRESHOLD = %d)\r\n",
+                d->alg->name, BI_WORDS_2048, BI_KARATSUBA_THRESHOLD);
+    }
+    uart_puts(buf);
+}
+
+static int op_bigint_private_crt(const bench_desc_t *d) {
+    (void)d;
+    rsa_private_op_crt(&bi_r, &bi_c, &bi_key);
+    return 0;
+}
+
+/* Variable-time sliding window on the private exponent, to price constant time */
+static int op_bigint_private_vt(const bench_desc_t *d) {
+    (void)d;
+    bi_mod_exp(&bi_r, &bi_c, &bi_d, &bi_n);
+    return 0;
+}
+
+static int op_rsa_private(const bench_desc_t *d) {
+    (void)d;
+    return mbedtls_rsa_private(&rsa, fake_rng, NULL, rsa_output, rsa_output_dec);
+}
 
-        sprintf(buf, "UART >> RSA-%d: Public Op took %lu cycles, Stack: %u bytes\r\n", bits, end - start, (unsigned int)stack_used);
-        HAL_UART_Transmit(&huart1, (uint8_t*)buf, strlen(buf), 1000);
-
-        /* 3. Private Key Operation (Decrypt) */
-        sprintf(buf, "UART >> RSA-%d: Starting Private Op...\r\n", bits);
-        HAL_UART_Transmit(&huart1, (uint8_t*)buf, strlen(buf), 1000);
-
-        stack_watermark_init();
-        cycles_reset();
-        start = cycles_get();
-        ret = mbedtls_rsa_private(&rsa, fake_rng, NULL, output, output_dec);
-        end = cycles_get();
-        stack_used = stack_watermark_get_usage();
-
-        if(ret != 0) {
-            sprintf(buf, "UART >> RSA-%d: Private Op Failed (-0x%04X)\r\n", bits, -ret);
-            HAL_UART_Transmit(&huart1, (uint8_t*)buf, strlen(buf), 1000);
-            mbedtls_rsa_free(&rsa);
-            continue;
+#if defined(MBEDTLS_RSA_RESTARTABLE)
+/* Budget per mbedtls_rsa_private_restartable() call, in Montgomery
+ * multiplications modulo P (see mbedtls_rsa_set_max_ops()) */
+#ifndef BENCH_RSA_SLICE_OPS
+#define BENCH_RSA_SLICE_OPS 32
+#endif
+#define BENCH_STR_(x) #x
+#define BENCH_STR(x)  BENCH_STR_(x)
+
+static mbedtls_rsa_restart_ctx rsa_rs;
+static uint32_t rsa_slice_worst;
+
+/* The restart context is reset by every completed or failed operation.
+ * One unmeasured op first: the first call on a fresh key sets up blinding
+ * and R^2 mod P/Q in one slice, which is key load, not slicing. */
+static int setup_rsa_private_sliced(const bench_desc_t *d) {
+    int ret;
+
+    mbedtls_rsa_restart_init(&rsa_rs);
+    ret = setup_rsa_private(d);
+    if (ret == 0) {
+        ret = d->run(d);
+    }
+    return ret;
+}
+
+/* The measured region covers all slices; each call is also timed on its
+ * own (32-bit, one slice is far below the counter period) */
+static int op_rsa_private_sliced(const bench_desc_t *d) {
+    int ret;
+    (void)d;
+
+    rsa_slice_worst = 0;
+    mbedtls_rsa_set_max_ops(BENCH_RSA_SLICE_OPS);
+    do {
+        uint32_t start = cycles_get();
+        ret = mbedtls_rsa_private_restartable(&rsa, fake_rng, NULL, rsa_output, rsa_output_dec, &rsa_rs);
+        uint32_t t = cycles_get() - start;
+        if (t > rsa_slice_worst) {
+            rsa_slice_worst = t;
         }
+    } while (ret == MBEDTLS_ERR_RSA_IN_PROGRESS);
+    mbedtls_rsa_set_max_ops(0);
+    return ret;
+}
 
-        sprintf(buf, "UART >> RSA-%d: Private Op took %lu cycles, Stack: %u bytes\r\n", bits, end - start, (unsigned int)stack_used);
-        HAL_UART_Transmit(&huart1, (uint8_t*)buf, strlen(buf), 1000);
+static uint32_t metric_rsa_private_sliced(const bench_desc_t *d) {
+    (void)d;
+    return rsa_slice_worst;
+}
+#endif
 
-        mbedtls_rsa_free(&rsa);
+/* --- Allocator comparison ---
+ * The Arena and Buffer Alloc entries run the RSA public/private op with
+ * another allocator behind heap_stats. Each run loads the key into a pool
+ * taken from the newlib heap, so the key, its cached values and the
+ * temporaries all live there; teardown drops the pool in one go. */
+
+/* Pool per run. Frees below the top only come back at the reset, so the
+ * arena needs far more than the live peak: ~44 KB for RSA-4096 Private Op */
+#ifndef BENCH_ALLOC_POOL_BYTES
+#define BENCH_ALLOC_POOL_BYTES (64 * 1024)
+#endif
+
+typedef enum {
+    BENCH_ALLOC_ARENA,
+    BENCH_ALLOC_BUFFER,
+} bench_alloc_t;
+
+static void *alloc_pool;
+
+/* Arena fill after the unmeasured pre-run, where the measured op starts */
+static size_t arena_base;
+
+/* Backend of the newlib (or TLSF) entries, put back by rsa_alloc_end() */
+static heap_stats_calloc_fn_t alloc_saved_calloc;
+static heap_stats_free_fn_t alloc_saved_free;
+
+/* The key slot belongs to the current backend: empty it before a switch */
+static void rsa_alloc_release_key(void) {
+    mbedtls_rsa_free(&rsa);
+    mbedtls_rsa_init(&rsa);
+    key_owner = NULL;
+}
+
+static void rsa_alloc_end(bench_alloc_t alloc) {
+    rsa_alloc_release_key();
+    heap_stats_set_backend(alloc_saved_calloc, alloc_saved_free);
+    if (alloc == BENCH_ALLOC_ARENA) {
+        arena_reset();
+    } else {
+        mbedtls_memory_buffer_alloc_free();
     }
+    free(alloc_pool);
+    alloc_pool = NULL;
+}
+
+/* Switches the backend, loads the key and runs the op once unmeasured, so
+ * the key has the cached values (R^2 mod N, blinding) of the newlib entries */
+static int setup_rsa_alloc(const bench_desc_t *d, bench_alloc_t alloc,
+                           int (*setup)(const bench_desc_t *d)) {
+    arena_stats_t st;
+    int ret;
+
+    alloc_pool = malloc(BENCH_ALLOC_POOL_BYTES);
+    if (alloc_pool == NULL) {
+        return MBEDTLS_ERR_MPI_ALLOC_FAILED;
+    }
+    rsa_alloc_release_key();
+    heap_stats_get_backend(&alloc_saved_calloc, &alloc_saved_free);
+    if (alloc == BENCH_ALLOC_ARENA) {
+        arena_alloc_init(alloc_pool, BENCH_ALLOC_POOL_BYTES);
+        heap_stats_set_backend(arena_calloc, arena_free);
+    } else {
+        /* Installs its own calloc/free: put the shim back on top */
+        mbedtls_memory_buffer_alloc_init(alloc_pool, BENCH_ALLOC_POOL_BYTES);
+        heap_stats_init();
+        heap_stats_set_backend(mbedtls_memory_buffer_calloc, mbedtls_memory_buffer_free);
+    }
+
+    ret = setup(d);
+    if (ret == 0) {
+        ret = d->run(d);
+    }
+    if (ret != 0) {
+        rsa_alloc_end(alloc);
+    } else if (alloc == BENCH_ALLOC_ARENA) {
+        arena_reset_peak();
+        arena_get(&st);
+        arena_base = st.used;
+    }
+    return ret;
+}
+
+static int setup_rsa_public_arena(const bench_desc_t *d) {
+    return setup_rsa_alloc(d, BENCH_ALLOC_ARENA, setup_rsa_public);
+}
+
+static int setup_rsa_private_arena(const bench_desc_t *d) {
+    return setup_rsa_alloc(d, BENCH_ALLOC_ARENA, setup_rsa_private);
+}
+
+static int setup_rsa_public_buffer(const bench_desc_t *d) {
+    return setup_rsa_alloc(d, BENCH_ALLOC_BUFFER, setup_rsa_public);
+}
+
+static int setup_rsa_private_buffer(const bench_desc_t *d) {
+    return setup_rsa_alloc(d, BENCH_ALLOC_BUFFER, setup_rsa_private);
+}
+
+/* Arena growth of the measured op, above the key and the pre-run's leftovers;
+ * read before check_rsa_public() runs a private op in the arena */
+static uint32_t metric_rsa_arena(const bench_desc_t *d) {
+    arena_stats_t st;
+    (void)d;
+
+    arena_get(&st);
+    return (uint32_t)(st.peak - arena_base);
+}
+
+static void teardown_rsa_arena(const bench_desc_t *d, int ret) {
+    (void)d;
+    (void)ret;
+    rsa_alloc_end(BENCH_ALLOC_ARENA);
+}
+
+static void teardown_rsa_buffer(const bench_desc_t *d, int ret) {
+    (void)d;
+    (void)ret;
+    rsa_alloc_end(BENCH_ALLOC_BUFFER);
+}
+
+/* --- Registry --- */
+
+static const bench_alg_t alg_mldsa44 = {
+    "ML-DSA-44", "PQC: ML-DSA-44 (Dilithium2 - ASM)", 0, keypair_mldsa44,
+    mldsa44_sign, mldsa44_verify, NULL, NULL, TELEMETRY_ALG_MLDSA44 };
+static const bench_alg_t alg_mlkem512 = {
+    "ML-KEM-512", "PQC: ML-KEM-512 (Kyber512 - ASM)", 0, keypair_mlkem512,
+    NULL, NULL, mlkem512_encaps, mlkem512_decaps, TELEMETRY_ALG_MLKEM512 };
+static const bench_alg_t alg_falcon512 = {
+    "Falcon-512", "PQC: Falcon-512 (Clean C)", 0, keypair_falcon512,
+    falcon512_sign, falcon512_verify, NULL, NULL, TELEMETRY_ALG_FALCON512 };
+static const bench_alg_t alg_sphincs = {
+    "SPHINCS+", "PQC: SPHINCS+ (SHA2-128s - Clean C)", 0, keypair_sphincs,
+    sphincs_sign, sphincs_verify, NULL, NULL, TELEMETRY_ALG_SPHINCS };
+static const bench_alg_t alg_rsa2048 = {
+    "RSA-2048", "RSA-2048", 2048, keypair_rsa, NULL, NULL, NULL, NULL, TELEMETRY_ALG_RSA2048 };
+static const bench_alg_t alg_rsa3072 = {
+    "RSA-3072", "RSA-3072", 3072, keypair_rsa, NULL, NULL, NULL, NULL, TELEMETRY_ALG_RSA3072 };
+static const bench_alg_t alg_rsa4096 = {
+    "RSA-4096", "RSA-4096", 4096, keypair_rsa, NULL, NULL, NULL, NULL, TELEMETRY_ALG_RSA4096 };
+static const bench_alg_t alg_bigint2048 = {
+    "BigInt-2048", "RSA-2048 (custom BigInt, RSA/Src)", 2048, keypair_bigint, NULL, NULL, NULL, NULL,
+    TELEMETRY_ALG_BIGINT2048 };
+static const bench_alg_t alg_bigint3072 = {
+    "BigInt-3072", "RSA-3072 (custom BigInt, RSA/Src)", 3072, keypair_bigint, NULL, NULL, NULL, NULL,
+    TELEMETRY_ALG_BIGINT3072 };
+static const bench_alg_t alg_bigint4096 = {
+    "BigInt-4096", "RSA-4096 (custom BigInt, RSA/Src)", 4096, keypair_bigint, NULL, NULL, NULL, NULL,
+    TELEMETRY_ALG_BIGINT4096 };
+
+/* KeyGen uses the sieved prime search; KeyGen Stock the original one on
+ * the same random stream */
+#if defined(MBEDTLS_GENPRIME_SIEVE)
+#define BENCH_RSA_KEYGEN_STOCK(ALG) \
+    { &ALG, "KeyGen Stock", TELEMETRY_OP_KEYGEN_STOCK, BENCH_SUITE_RSA_KEYGEN, setup_keygen_stock, op_rsa_keygen, \
+      teardown_keygen_stock, check_rsa_keys, 0, 0, 0, 0, 0, BENCH_REPEAT_SLOW },
+#else
+#define BENCH_RSA_KEYGEN_STOCK(ALG)
+#endif
+
+/* Private Op Sliced: mbedtls_rsa_private_restartable() run to completion in
+ * calls of BENCH_RSA_SLICE_OPS; total cycles as usual, worst call as text */
+#if defined(MBEDTLS_RSA_RESTARTABLE)
+#define BENCH_RSA_SLICED(ALG) \
+    , { &ALG, "Private Op Sliced", TELEMETRY_OP_PRIVATE_SLICED, BENCH_SUITE_RSA, \
+      setup_rsa_private_sliced, op_rsa_private_sliced, NULL, check_rsa_private, 0, 0, 0, 0, 0, \
+      BENCH_ITERATIONS_SLOW, 0, BENCH_CACHE_WARM, metric_rsa_private_sliced, \
+      "worst slice %lu cycles (" BENCH_STR(BENCH_RSA_SLICE_OPS) " ops per call)" }
+#else
+#define BENCH_RSA_SLICED(ALG)
+#endif
+
+/* Public/Private Op on the arena (dropped when the op ends) and on
+ * mbedtls_memory_buffer_alloc, next to the newlib malloc entries above */
+#define BENCH_RSA_ALLOC(ALG) \
+    , { &ALG, "Public Op Arena", TELEMETRY_OP_PUBLIC_ARENA, BENCH_SUITE_RSA, setup_rsa_public_arena, \
+      op_rsa_public, teardown_rsa_arena, check_rsa_public, 0, 0, 0, 0, 0, BENCH_ITERATIONS, BENCH_WARMUP, \
+      BENCH_CACHE_BOTH, metric_rsa_arena, "arena high-water %lu bytes above setup" }, \
+    { &ALG, "Private Op Arena", TELEMETRY_OP_PRIVATE_ARENA, BENCH_SUITE_RSA, setup_rsa_private_arena, \
+      op_rsa_private, teardown_rsa_arena, check_rsa_private, 0, 0, 0, 0, 0, BENCH_ITERATIONS_SLOW, 0, \
+      BENCH_CACHE_WARM, metric_rsa_arena, "arena high-water %lu bytes above setup" }, \
+    { &ALG, "Public Op Buffer Alloc", TELEMETRY_OP_PUBLIC_BUFFER, BENCH_SUITE_RSA, setup_rsa_public_buffer, \
+      op_rsa_public, teardown_rsa_buffer, check_rsa_public, 0, 0, 0, 0, 0, BENCH_REPEAT_DEFAULT }, \
+    { &ALG, "Private Op Buffer Alloc", TELEMETRY_OP_PRIVATE_BUFFER, BENCH_SUITE_RSA, setup_rsa_private_buffer, \
+      op_rsa_private, teardown_rsa_buffer, check_rsa_private, 0, 0, 0, 0, 0, BENCH_REPEAT_SLOW }
+
+/* Public Op and Private Op both check the full public/private round trip
+ * with the same key (from the key store, or from a KeyGen run just before). */
+#define BENCH_RSA_ENTRIES(ALG) \
+    { &ALG, "KeyGen", TELEMETRY_OP_KEYGEN, BENCH_SUITE_RSA_KEYGEN, setup_keygen, op_rsa_keygen, teardown_keygen, \
+      check_rsa_keys, 0, 0, 0, 0, 0, BENCH_REPEAT_SLOW }, \
+    BENCH_RSA_KEYGEN_STOCK(ALG) \
+    { &ALG, "Public Op",  TELEMETRY_OP_PUBLIC, BENCH_SUITE_RSA, setup_rsa_public,  op_rsa_public,  NULL, \
+      check_rsa_public, 0, 0, 0, 0, 0, BENCH_REPEAT_DEFAULT }, \
+    { &ALG, "Private Op", TELEMETRY_OP_PRIVATE, BENCH_SUITE_RSA, setup_rsa_private, op_rsa_private, NULL, \
+      check_rsa_private, 0, 0, 0, 0, 0, BENCH_REPEAT_SLOW } \
+    BENCH_RSA_SLICED(ALG) \
+    BENCH_RSA_ALLOC(ALG)
+
+/* Custom BigInt RSA on an mbedTLS-generated key of the same size.
+ * Private Op (plain, like mbedTLS with MBEDTLS_RSA_NO_CRT) and Private Op CRT
+ * (like the default mbedtls_rsa_private()) follow RSA_PRIVATE_CONSTANT_TIME. */
+#define BENCH_BIGINT_ENTRIES(ALG) \
+    { &ALG, "Public Op",  TELEMETRY_OP_PUBLIC, BENCH_SUITE_RSA, setup_bigint_public, op_bigint_public, NULL, \
+      check_bigint_public, 0, 0, 0, 0, 0, BENCH_REPEAT_DEFAULT }, \
+    { &ALG, "Private Op", TELEMETRY_OP_PRIVATE, BENCH_SUITE_RSA, setup_bigint_private, op_bigint_private, NULL, \
+      check_bigint_private, 0, 0, 0, 0, 0, BENCH_REPEAT_SLOW }, \
+    { &ALG, "Private Op CRT", TELEMETRY_OP_PRIVATE_CRT, BENCH_SUITE_RSA, setup_bigint_private, \
+      op_bigint_private_crt, NULL, check_bigint_private, 0, 0, 0, 0, 0, BENCH_REPEAT_SLOW }, \
+    BENCH_BIGINT_REDUCE_ENTRIES(ALG)
+
+/* Montgomery vs. Barrett reduction on the public op, with the per-modulus
+ * context built inside the measured call (one-shot) or once in setup (keyed) */
+#define BENCH_BIGINT_REDUCE_ENTRIES(ALG) \
+    { &ALG, "Public Mont", TELEMETRY_OP_MONT_ONCE, BENCH_SUITE_RSA, setup_bigint_public, \
+      op_bigint_mont_once, NULL, check_bigint_public, 0, 0, 0, 0, 0, BENCH_REPEAT_DEFAULT }, \
+    { &ALG, "Public Barrett", TELEMETRY_OP_BARR_ONCE, BENCH_SUITE_RSA, setup_bigint_public, \
+      op_bigint_barrett_once, NULL, check_bigint_public, 0, 0, 0, 0, 0, BENCH_REPEAT_DEFAULT }, \
+    { &ALG, "Public Mont Keyed", TELEMETRY_OP_MONT_KEYED, BENCH_SUITE_RSA, setup_bigint_mont, \
+      op_bigint_mod_keyed, NULL, check_bigint_public, 0, 0, 0, 0, 0, BENCH_REPEAT_DEFAULT }, \
+    { &ALG, "Public Barrett Keyed", TELEMETRY_OP_BARR_KEYED, BENCH_SUITE_RSA, setup_bigint_barrett, \
+      op_bigint_mod_keyed, NULL, check_bigint_public, 0, 0, 0, 0, 0, BENCH_REPEAT_DEFAULT }
+
+/* Signature scheme: Keygen, Sign and Verify with shared buffer requirements */
+#define BENCH_SIGN_ENTRIES(ALG, PK, SK, SIG, KEYGEN_CHECK, KEYGEN_REPEAT, SIGN_REPEAT) \
+    { &ALG, "Keygen", TELEMETRY_OP_KEYGEN, BENCH_SUITE_PQC, setup_keygen, op_keypair, teardown_keygen, \
+      KEYGEN_CHECK, PK, SK, SIG, 0, 0, KEYGEN_REPEAT }, \
+    { &ALG, "Sign", TELEMETRY_OP_SIGN, BENCH_SUITE_PQC, setup_sign, op_sign, NULL, \
+      check_signature, PK, SK, SIG, 0, 0, SIGN_REPEAT }, \
+    { &ALG, "Verify", TELEMETRY_OP_VERIFY, BENCH_SUITE_PQC, setup_verify, op_verify, NULL, \
+      check_signature, PK, SK, SIG, 0, 0, BENCH_REPEAT_DEFAULT }
+
+static const bench_desc_t bench_registry[] = {
+    BENCH_SIGN_ENTRIES(alg_mldsa44, MLDSA44_PUBLICKEYBYTES, MLDSA44_SECRETKEYBYTES, MLDSA44_BYTES,
+                       check_keys, BENCH_REPEAT_DEFAULT, BENCH_REPEAT_DEFAULT),
+
+    { &alg_mlkem512, "Keygen", TELEMETRY_OP_KEYGEN, BENCH_SUITE_PQC, setup_keygen, op_keypair, teardown_keygen,
+      check_keys, MLKEM512_PUBLICKEYBYTES, MLKEM512_SECRETKEYBYTES, 0, MLKEM512_CIPHERTEXTBYTES,
+      MLKEM512_SSBYTES, BENCH_REPEAT_DEFAULT },
+    { &alg_mlkem512, "Encaps", TELEMETRY_OP_ENCAPS, BENCH_SUITE_PQC, setup_need_keys, op_encaps, NULL,
+      check_encaps, MLKEM512_PUBLICKEYBYTES, MLKEM512_SECRETKEYBYTES, 0, MLKEM512_CIPHERTEXTBYTES,
+      MLKEM512_SSBYTES, BENCH_REPEAT_DEFAULT },
+    { &alg_mlkem512, "Decaps", TELEMETRY_OP_DECAPS, BENCH_SUITE_PQC, setup_decaps, op_decaps, NULL,
+      check_shared_secret, MLKEM512_PUBLICKEYBYTES, MLKEM512_SECRETKEYBYTES, 0, MLKEM512_CIPHERTEXTBYTES,
+      MLKEM512_SSBYTES, BENCH_REPEAT_DEFAULT },
+
+    BENCH_SIGN_ENTRIES(alg_falcon512, PQCLEAN_FALCON512_CLEAN_CRYPTO_PUBLICKEYBYTES,
+                       PQCLEAN_FALCON512_CLEAN_CRYPTO_SECRETKEYBYTES, PQCLEAN_FALCON512_CLEAN_CRYPTO_BYTES,
+                       check_keys, BENCH_REPEAT_SLOW, BENCH_REPEAT_DEFAULT),
+
+    BENCH_SIGN_ENTRIES(alg_sphincs, PQCLEAN_SPHINCSSHA2128SSIMPLE_CLEAN_CRYPTO_PUBLICKEYBYTES,
+                       PQCLEAN_SPHINCSSHA2128SSIMPLE_CLEAN_CRYPTO_SECRETKEYBYTES,
+                       PQCLEAN_SPHINCSSHA2128SSIMPLE_CLEAN_CRYPTO_BYTES,
+                       NULL, BENCH_REPEAT_SLOW, BENCH_REPEAT_SLOW),
+
+    BENCH_RSA_ENTRIES(alg_rsa2048),
+    BENCH_RSA_ENTRIES(alg_rsa3072),
+    BENCH_RSA_ENTRIES(alg_rsa4096),
+
+    /* Montgomery (CIOS) vs. the original bit-serial multiplier, same key.
+     * Private Op VT is always variable time. */
+    BENCH_BIGINT_ENTRIES(alg_bigint2048),
+    { &alg_bigint2048, "Public Op Ref", TELEMETRY_OP_PUBLIC_REF, BENCH_SUITE_RSA, setup_bigint_public,
+      op_bigint_public_ref, NULL, check_bigint_public, 0, 0, 0, 0, 0, BENCH_REPEAT_SLOW },
+    { &alg_bigint2048, "Private Op VT", TELEMETRY_OP_PRIVATE_VT, BENCH_SUITE_RSA, setup_bigint_private,
+      op_bigint_private_vt, NULL, check_bigint_private, 0, 0, 0, 0, 0, BENCH_REPEAT_SLOW },
+    { &alg_bigint2048, "Mul", TELEMETRY_OP_MUL, BENCH_SUITE_RSA, setup_bigint_mul,
+      op_bigint_mul, NULL, check_bigint_mul, 0, 0, 0, 0, 0, BENCH_REPEAT_DEFAULT },
+    { &alg_bigint2048, "Mul Crossover", TELEMETRY_OP_MUL_SWEEP, BENCH_SUITE_RSA, setup_bigint_mul,
+      op_bigint_mul_sweep, teardown_bigint_mul_sweep, NULL, 0, 0, 0, 0, 0, BENCH_REPEAT_ONCE },
+    BENCH_BIGINT_ENTRIES(alg_bigint3072),
+    BENCH_BIGINT_ENTRIES(alg_bigint4096),
+};
+
+#define BENCH_COUNT (sizeof(bench_registry) / sizeof(bench_registry[0]))
+
+/* ------------------------------------------------------------------
+ * Generic runner
+ * ----------------------------------------------------------------*/
+
+/* Last banner printed, so consecutive ops of one algorithm share a header */
+static const bench_alg_t *banner_alg;
+
+/* Emit framed binary records (telemetry.h) instead of text lines */
+static int bench_binary;
+
+/* On-device sample buffer, one cycle count per measured iteration */
+static uint64_t samples[BENCH_MAX_SAMPLES];
+
+/* Cost of an empty timed region per cache mode, subtracted from every sample */
+static uint64_t bench_overhead[2];
+static int bench_calibrated;
+
+#define BENCH_CALIBRATION_RUNS 32
+
+static void bench_cache_clean(void) {
+    SCB_CleanInvalidateDCache();
+    SCB_InvalidateICache();
+}
+
+/* Minimum over several empty regions, taken the same way bench_call() times an op */
+static void bench_calibrate(void) {
+    uint64_t start, end;
+
+    for (int cold = 0; cold < 2; cold++) {
+        bench_overhead[cold] = UINT64_MAX;
+        for (int i = 0; i < BENCH_CALIBRATION_RUNS; i++) {
+            if (cold) {
+                bench_cache_clean();
+            }
+            start = cycles_get64();
+            end = cycles_get64();
+            if (end - start < bench_overhead[cold]) {
+                bench_overhead[cold] = end - start;
+            }
+        }
+    }
+    bench_calibrated = 1;
+}
+
+/* Measured region, run under the stack watermark */
+typedef struct {
+    const bench_desc_t *d;
+    int cold;
+    uint64_t cycles;
+    int ret;
+} bench_call_t;
+
+static void bench_call(void *arg) {
+    bench_call_t *c = (bench_call_t *)arg;
+    uint64_t start, end;
+
+    if (c->cold) {
+        bench_cache_clean();
+    }
+    start = cycles_get64();
+    c->ret = c->d->run(c->d);
+    end = cycles_get64();
+    c->cycles = end - start;
+    c->cycles = c->cycles > bench_overhead[c->cold] ? c->cycles - bench_overhead[c->cold] : 0;
+}
+
+/* One setup/run/teardown cycle; cycles, stack, heap and metric are only valid on success */
+static int bench_measure(const bench_desc_t *d, int cold, uint64_t *cycles, size_t *stack_used,
+                         heap_stats_t *heap, uint32_t *metric) {
+    bench_call_t call = { d, cold, 0, 0 };
+    int ret;
+
+    ret = d->setup ? d->setup(d) : 0;
+    if (ret != 0) {
+        return ret;
+    }
+
+    /* Drain queued output so no UART interrupt lands in the timed region */
+    uart_log_flush();
+    heap_stats_reset();
+    *stack_used = stack_watermark_measure(bench_call, &call);
+    heap_stats_get(heap);
+    *metric = call.ret == 0 && d->metric ? d->metric(d) : 0;
+
+    if (call.ret == 0 && d->check && d->check(d) != 0) {
+        call.ret = BENCH_ERR_CHECK;
+    }
+
+    if (d->teardown) {
+        d->teardown(d, call.ret);
+    }
+    *cycles = call.cycles;
+    return call.ret;
+}
+
+/* Emits one binary record (binary output mode only) */
+static void bench_emit_record(const bench_desc_t *d, uint32_t iteration, uint8_t flags,
+                              uint64_t cycles, size_t stack_used, const heap_stats_t *heap) {
+    telemetry_record_t rec;
+    uint8_t frame[TELEMETRY_FRAME_MAX];
+    size_t len;
+
+    rec.alg_id = (uint8_t)d->alg->id;
+    rec.op_id = (uint8_t)d->op_id;
+    rec.flags = flags;
+    rec.iteration = (uint16_t)iteration;
+    rec.cycles = cycles;
+    rec.stack = (uint32_t)stack_used;
+    rec.heap = heap ? (uint32_t)heap->peak : 0;
+    rec.allocs = heap ? (uint16_t)(heap->allocs > 0xFFFF ? 0xFFFF : heap->allocs) : 0;
+    rec.frees = heap ? (uint16_t)(heap->frees > 0xFFFF ? 0xFFFF : heap->frees) : 0;
+    rec.alloc_cycles = heap ? heap->cycles : 0;
+    rec.alloc_worst = heap ? heap->worst : 0;
+    len = telemetry_encode(&rec, frame);
+    uart_log_write(frame, len);
+}
+
+/* Runs all iterations of one descriptor in one cache mode. In binary mode
+ * only records go out from here; text from teardown hooks (Karatsuba sweep)
+ * and bench_run() (header, TLSF heap report) is still printed, and
+ * telemetry.py drops whatever is not a COBS frame with a valid CRC. */
+static void bench_run_mode(const bench_desc_t *d, int cold) {
+    uint64_t cycles = 0;
+    size_t stack_used = 0, stack_peak = 0;
+    heap_stats_t heap, heap_peak = { 0, 0, 0, 0, 0, 0 };
+    uint32_t metric = 0, metric_peak = 0;
+    bench_stats_t st;
+    char buf[256];
+    char op[40];
+    char c0[24], c1[24], c2[24], c3[24], c4[24];
+    uint32_t n = d->iterations < BENCH_MAX_SAMPLES ? d->iterations : BENCH_MAX_SAMPLES;
+    /* Every cold run starts from flushed caches, so pre-runs buy nothing */
+    uint32_t warmup = cold ? 0 : d->warmup;
+    uint8_t flags = cold ? TELEMETRY_FLAG_COLD : 0;
+    int ret;
+
+    /* Warm results keep the plain operation name the reports already use */
+    snprintf(op, sizeof(op), cold ? "%s (cold)" : "%s", d->op);
+
+    if (!bench_binary) {
+        sprintf(buf, "UART >> %s: Starting %s (%u runs, %u warm-up)...\r\n",
+                d->alg->name, op, (unsigned int)n, (unsigned int)warmup);
+        uart_puts(buf);
+    }
+
+    for (uint32_t i = 0; i < warmup + n; i++) {
+        ret = bench_measure(d, cold, &cycles, &stack_used, &heap, &metric);
+        if (ret != 0) {
+            if (ret == BENCH_ERR_CHECK) {
+                flags |= TELEMETRY_FLAG_CHECK;
+            }
+            if (bench_binary) {
+                bench_emit_record(d, i, flags | TELEMETRY_FLAG_FAILED, (uint64_t)(uint32_t)-ret, 0, NULL);
+            } else if (ret == BENCH_ERR_CHECK) {
+                sprintf(buf, "UART >> %s: %s Failed (wrong result)\r\n", d->alg->name, op);
+                uart_puts(buf);
+            } else {
+                sprintf(buf, "UART >> %s: %s Failed (-0x%04X)\r\n", d->alg->name, op, (unsigned int)-ret);
+                uart_puts(buf);
+            }
+            return;
+        }
+        if (i >= warmup) {
+            samples[i - warmup] = cycles;
+            if (stack_used > stack_peak) stack_peak = stack_used;
+            if (heap.peak > heap_peak.peak) heap_peak.peak = heap.peak;
+            if (heap.allocs > heap_peak.allocs) heap_peak.allocs = heap.allocs;
+            if (heap.frees > heap_peak.frees) heap_peak.frees = heap.frees;
+            if (heap.cycles > heap_peak.cycles) heap_peak.cycles = heap.cycles;
+            if (heap.worst > heap_peak.worst) heap_peak.worst = heap.worst;
+            if (metric > metric_peak) metric_peak = metric;
+            if (bench_binary) {
+                bench_emit_record(d, i - warmup, flags, cycles, stack_used, &heap);
+            }
+        }
+    }
+
+    /* Binary consumers get every sample and compute statistics host-side */
+    if (bench_binary) {
+        return;
+    }
+
+    bench_stats_compute(samples, n, &st);
+
+    /* Median is the headline figure; scripts parse this line */
+    sprintf(buf, "UART >> %s: %s took %s cycles, Stack: %u bytes, Heap: %u bytes (%u allocs, %u frees), "
+            "Alloc: %lu cycles (worst call %lu)\r\n",
+            d->alg->name, op, u64_to_str(c0, st.median), (unsigned int)stack_peak,
+            (unsigned int)heap_peak.peak, (unsigned int)heap_peak.allocs, (unsigned int)heap_peak.frees,
+            (unsigned long)heap_peak.cycles, (unsigned long)heap_peak.worst);
+    uart_puts(buf);
+    sprintf(buf, "UART >> %s: %s stats: n=%u min=%s median=%s p90=%s max=%s stddev=%s\r\n",
+            d->alg->name, op, (unsigned int)st.n, u64_to_str(c0, st.min), u64_to_str(c1, st.median),
+            u64_to_str(c2, st.p90), u64_to_str(c3, st.max), u64_to_str(c4, st.stddev));
+    uart_puts(buf);
+    if (d->metric) {
+        sprintf(buf, "UART >> %s: %s ", d->alg->name, op);
+        sprintf(buf + strlen(buf), d->metric_fmt, (unsigned long)metric_peak);
+        strcat(buf, "\r\n");
+        uart_puts(buf);
+    }
+}
+
+#if defined(PQC_HEAP_TLSF)
+/* TLSF pool state after an entry, as a long-lived heap is left by it */
+static void bench_heap_report(const bench_desc_t *d) {
+    tlsf_stats_t st;
+    char buf[192];
+
+    tlsf_get_stats(&st);
+    sprintf(buf, "UART >> %s: %s heap: %u of %u bytes free in %u blocks, largest %u, fragmentation %u.%u%%, "
+            "worst malloc %lu, worst free %lu cycles\r\n",
+            d->alg->name, d->op, (unsigned int)st.free, (unsigned int)st.size, (unsigned int)st.free_blocks,
+            (unsigned int)st.largest_free, (unsigned int)(st.frag_permille / 10),
+            (unsigned int)(st.frag_permille % 10), (unsigned long)st.worst_malloc,
+            (unsigned long)st.worst_free);
+    uart_puts(buf);
+}
+#endif
+
+static void bench_run(const bench_desc_t *d) {
+    char buf[128];
+    char c0[24], c1[24];
+
+    if (d->pk_bytes > sizeof(pk) || d->sk_bytes > sizeof(sk) ||
+        d->sig_bytes > sizeof(sig) || d->ct_bytes > sizeof(ct) ||
+        d->ss_bytes > sizeof(ss1)) {
+        sprintf(buf, "UART >> %s: %s Failed (buffers too small)\r\n", d->alg->name, d->op);
+        uart_puts(buf);
+        return;
+    }
+
+    /* Benchmark header, once per boot; printed in binary mode too */
+    if (!bench_calibrated) {
+        bench_calibrate();
+        sprintf(buf, "UART >> Build profile: %s (GCC %s)\r\n", PQC_BUILD_PROFILE, __VERSION__);
+        uart_puts(buf);
+        sprintf(buf, "UART >> Timer overhead: %s cycles warm, %s cycles cold (subtracted)\r\n",
+                u64_to_str(c0, bench_overhead[0]), u64_to_str(c1, bench_overhead[1]));
+        uart_puts(buf);
+    }
+
+    if (!bench_binary && banner_alg != d->alg) {
+        sprintf(buf, "\r\n--- %s ---\r\n", d->alg->banner);
+        uart_puts(buf);
+        banner_alg = d->alg;
+    }
+
+    if (d->cache_modes & BENCH_CACHE_COLD) {
+        bench_run_mode(d, 1);
+    }
+    if (d->cache_modes & BENCH_CACHE_WARM) {
+        bench_run_mode(d, 0);
+    }
+#if defined(PQC_HEAP_TLSF)
+    bench_heap_report(d);
+#endif
+}
+
+static void bench_run_suite(bench_suite_t suite) {
+    banner_alg = NULL;
+    for (size_t i = 0; i < BENCH_COUNT; i++) {
+        if (bench_registry[i].suite == suite) {
+            bench_run(&bench_registry[i]);
+        }
+    }
+}
+
+/* Case-insensitive ASCII compare; the lab types names by hand */
+static int name_equals(const char *a, const char *b) {
+    while (*a && *b) {
+        char ca = (*a >= 'a' && *a <= 'z') ? (char)(*a - 32) : *a;
+        char cb = (*b >= 'a' && *b <= 'z') ? (char)(*b - 32) : *b;
+        if (ca != cb) return 0;
+        a++;
+        b++;
+    }
+    return *a == *b;
+}
+
+void benchmark_rsa_suite(void) {
+    uart_puts("\r\n=== RSA Scalability Suite (2048, 3072, 4096) ===\r\n");
+    bench_run_suite(BENCH_SUITE_RSA);
+}
+
+void benchmark_rsa_keygen(void) {
+    uart_puts("\r\n=== RSA KeyGen (2048, 3072, 4096) ===\r\n");
+    bench_run_suite(BENCH_SUITE_RSA_KEYGEN);
 }
 
 void benchmark_pqc(void) {
-    uint32_t start, end;
-    size_t stack_used;
+    bench_run_suite(BENCH_SUITE_PQC);
+}
+
+void benchmark_set_binary_output(int enable) {
+    bench_binary = enable;
+}
+
+void benchmark_list(void) {
     char buf[128];
-    size_t siglen;
-
-    /* --- ML-DSA-44 (Dilithium2 - pqm4) --- */
-    sprintf(buf, "\r\n--- PQC: ML-DSA-44 (Dilithium2 - ASM) ---\r\n");
-    HAL_UART_Transmit(&huart1, (uint8_t*)buf, strlen(buf), 1000);
-
-    sprintf(buf, "UART >> ML-DSA-44: Starting Keygen...\r\n");
-    HAL_UART_Transmit(&huart1, (uint8_t*)buf, strlen(buf), 1000);
-
-    stack_watermark_init();
-    cycles_reset();
-    start = cycles_get();
-    // pqm4: crypto_sign_keypair
-    crypto_sign_keypair(pk, sk);
-    end = cycles_get();
-    stack_used = stack_watermark_get_usage();
-    sprintf(buf, "UART >> ML-DSA-44: Keygen took %lu cycles, Stack: %u bytes\r\n", end - start, (unsigned int)stack_used);
-    HAL_UART_Transmit(&huart1, (uint8_t*)buf, strlen(buf), 1000);
-
-    sprintf(buf, "UART >> ML-DSA-44: Starting Sign...\r\n");
-    HAL_UART_Transmit(&huart1, (uint8_t*)buf, strlen(buf), 1000);
-
-    stack_watermark_init();
-    cycles_reset();
-    start = cycles_get();
-    // pqm4: crypto_sign_signature_ctx
-    // Note: pqm4/api.h defines crypto_sign_signature as a macro calling _ctx with NULL, 0.
-    // Since we don't include that api.h, we call _ctx directly.
-    extern int crypto_sign_signature_ctx(uint8_t *sig, size_t *siglen, const uint8_t *m, size_t mlen, const uint8_t *ctx, size_t ctxlen, const uint8_t *sk);
-    crypto_sign_signature_ctx(sig, &siglen, (uint8_t*)"test", 4, NULL, 0, sk);
-    end = cycles_get();
-    stack_used = stack_watermark_get_usage();
-    sprintf(buf, "UART >> ML-DSA-44: Sign took %lu cycles, Stack: %u bytes\r\n", end - start, (unsigned int)stack_used);
-    HAL_UART_Transmit(&huart1, (uint8_t*)buf, strlen(buf), 1000);
-
-    /* --- ML-KEM-512 (Kyber512 - pqm4) --- */
-    sprintf(buf, "\r\n--- PQC: ML-KEM-512 (Kyber512 - ASM) ---\r\n");
-    HAL_UART_Transmit(&huart1, (uint8_t*)buf, strlen(buf), 1000);
-
-    sprintf(buf, "UART >> ML-KEM-512: Starting Keygen...\r\n");
-    HAL_UART_Transmit(&huart1, (uint8_t*)buf, strlen(buf), 1000);
-
-    stack_watermark_init();
-    cycles_reset();
-    start = cycles_get();
-    // pqm4: crypto_kem_keypair
-    crypto_kem_keypair(pk, sk);
-    end = cycles_get();
-    stack_used = stack_watermark_get_usage();
-    sprintf(buf, "UART >> ML-KEM-512: Keygen took %lu cycles, Stack: %u bytes\r\n", end - start, (unsigned int)stack_used);
-    HAL_UART_Transmit(&huart1, (uint8_t*)buf, strlen(buf), 1000);
-
-    sprintf(buf, "UART >> ML-KEM-512: Starting Encaps...\r\n");
-    HAL_UART_Transmit(&huart1, (uint8_t*)buf, strlen(buf), 1000);
-
-    stack_watermark_init();
-    cycles_reset();
-    start = cycles_get();
-    // pqm4: crypto_kem_enc
-    crypto_kem_enc(ct, ss1, pk);
-    end = cycles_get();
-    stack_used = stack_watermark_get_usage();
-    sprintf(buf, "UART >> ML-KEM-512: Encaps took %lu cycles, Stack: %u bytes\r\n", end - start, (unsigned int)stack_used);
-    HAL_UART_Transmit(&huart1, (uint8_t*)buf, strlen(buf), 1000);
-
-    /* --- Falcon-512 (PQClean - Legacy/C) --- */
-    sprintf(buf, "\r\n--- PQC: Falcon-512 (Clean C) ---\r\n");
-    HAL_UART_Transmit(&huart1, (uint8_t*)buf, strlen(buf), 1000);
-
-    sprintf(buf, "UART >> Falcon-512: Starting Keygen...\r\n");
-    HAL_UART_Transmit(&huart1, (uint8_t*)buf, strlen(buf), 1000);
-
-    stack_watermark_init();
-    cycles_reset();
-    start = cycles_get();
-    PQCLEAN_FALCON512_CLEAN_crypto_sign_keypair(pk, sk);
-    end = cycles_get();
-    stack_used = stack_watermark_get_usage();
-    sprintf(buf, "UART >> Falcon-512: Keygen took %lu cycles, Stack: %u bytes\r\n", end - start, (unsigned int)stack_used);
-    HAL_UART_Transmit(&huart1, (uint8_t*)buf, strlen(buf), 1000);
-
-    sprintf(buf, "UART >> Falcon-512: Starting Sign...\r\n");
-    HAL_UART_Transmit(&huart1, (uint8_t*)buf, strlen(buf), 1000);
-
-    stack_watermark_init();
-    cycles_reset();
-    start = cycles_get();
-    PQCLEAN_FALCON512_CLEAN_crypto_sign_signature(sig, &siglen, (uint8_t*)"test", 4, sk);
-    end = cycles_get();
-    stack_used = stack_watermark_get_usage();
-    sprintf(buf, "UART >> Falcon-512: Sign took %lu cycles, Stack: %u bytes\r\n", end - start, (unsigned int)stack_used);
-    HAL_UART_Transmit(&huart1, (uint8_t*)buf, strlen(buf), 1000);
-
-    /* --- SPHINCS+-sha2-128s-simple (PQClean - Legacy/C) --- */
-    sprintf(buf, "\r\n--- PQC: SPHINCS+ (SHA2-128s - Clean C) ---\r\n");
-    HAL_UART_Transmit(&huart1, (uint8_t*)buf, strlen(buf), 1000);
-
-    sprintf(buf, "UART >> SPHINCS+: Starting Keygen...\r\n");
-    HAL_UART_Transmit(&huart1, (uint8_t*)buf, strlen(buf), 1000);
-    stack_watermark_init();
-    cycles_reset();
-    start = cycles_get();
-    PQCLEAN_SPHINCSSHA2128SSIMPLE_CLEAN_crypto_sign_keypair(pk, sk);
-    end = cycles_get();
-    stack_used = stack_watermark_get_usage();
-    sprintf(buf, "UART >> SPHINCS+: Keygen took %lu cycles, Stack: %u bytes\r\n", end - start, (unsigned int)stack_used);
-    HAL_UART_Transmit(&huart1, (uint8_t*)buf, strlen(buf), 1000);
-
-    sprintf(buf, "UART >> SPHINCS+: Starting Sign...\r\n");
-    HAL_UART_Transmit(&huart1, (uint8_t*)buf, strlen(buf), 1000);
-    stack_watermark_init();
-    cycles_reset();
-    start = cycles_get();
-    PQCLEAN_SPHINCSSHA2128SSIMPLE_CLEAN_crypto_sign_signature(sig, &siglen, (uint8_t*)"test", 4, sk);
-    end = cycles_get();
-    stack_used = stack_watermark_get_usage();
-    sprintf(buf, "UART >> SPHINCS+: Sign took %lu cycles, Stack: %u bytes\r\n", end - start, (unsigned int)stack_used);
-    HAL_UART_Transmit(&huart1, (uint8_t*)buf, strlen(buf), 1000);
+    uart_puts("\r\n--- Available Benchmarks ---\r\n");
+    for (size_t i = 0; i < BENCH_COUNT; i++) {
+        sprintf(buf, "  %s %s\r\n", bench_registry[i].alg->name, bench_registry[i].op);
+        uart_puts(buf);
+    }
+}
+
+int benchmark_run_by_name(const char *name) {
+    char full[64];
+    int matched = 0;
+
+    banner_alg = NULL;
+    for (size_t i = 0; i < BENCH_COUNT; i++) {
+        const bench_desc_t *d = &bench_registry[i];
+        snprintf(full, sizeof(full), "%s %s", d->alg->name, d->op);
+        /* A bare algorithm name leaves out the opt-in entries */
+        if (name_equals(name, full) ||
+            (d->suite != BENCH_SUITE_RSA_KEYGEN && name_equals(name, d->alg->name))) {
+            bench_run(d);
+            matched++;
+        }
+    }
+    return matched;
 }
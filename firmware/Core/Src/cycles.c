@@ -1,5 +1,8 @@
 #include "cycles.h"
 
+/* 64-bit extension of DWT->CYCCNT, shared between thread mode and SysTick */
+static cycles_ext_t cycles_ext;
+
 void cycles_init(void) {
     /* 1. Enable TRCENA bit in DEMCR (Debug Exception and Monitor Control Register) 
      *    This must be set before accessing DWT registers. */
@@ -9,8 +12,30 @@ void cycles_init(void) {
     DWT->LAR = 0xC5ACCE55; 
     
     /* 3. Reset the counter */
-    DWT->CYCCNT = 0;
+    cycles_reset();
 
     /* 4. Enable the cycle counter bit in DWT control register */
     DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
 }
+
+void cycles_reset(void) {
+    uint32_t primask = __get_PRIMASK();
+    __disable_irq();
+    DWT->CYCCNT = 0;
+    cycles_ext.high = 0;
+    cycles_ext.last = 0;
+    __set_PRIMASK(primask);
+}
+
+uint64_t cycles_get64(void) {
+    /* Read-modify-write of the extension must not race the SysTick poll */
+    uint32_t primask = __get_PRIMASK();
+    __disable_irq();
+    uint64_t now = cycles_extend(&cycles_ext, DWT->CYCCNT);
+    __set_PRIMASK(primask);
+    return now;
+}
+
+void cycles_poll(void) {
+    (void)cycles_get64();
+}
@@ -13,6 +13,8 @@
 #include <stdio.h>
 #include "cycles.h"
 #include "crypto_harness.h"
+#include "uart_log.h"
+#include "heap_stats.h"
 
 /* ------------------------------------------------------------------
  * Private function prototypes
@@ -21,6 +23,7 @@ static void SystemClock_Config(void);
 static void MX_GPIO_Init(void);
 static void MX_USART1_UART_Init(UART_HandleTypeDef *huart);
 static void Error_Handler(void);
+static size_t UART_ReadLine(char *buf, size_t len);
 
 /* ------------------------------------------------------------------
  * Global handle
@@ -43,11 +46,13 @@ int main(void)
     MX_USART1_UART_Init(&huart1);
 
     cycles_init();
+    uart_log_init();
+    heap_stats_init();
 
     /* Transmit hello message -----------------------------------*/
     char msg[128];
     sprintf(msg, "\r\n--- PQC Demo: Milestone 2 Execution ---\r\n");
-    HAL_UART_Transmit(&huart1, (uint8_t*)msg, strlen(msg), 1000);
+    uart_log_puts(msg);
 
     /* Main loop ------------------------------------------------*/
     uint8_t rx_buf[1];
@@ -55,25 +60,31 @@ int main(void)
                  "1. Run RSA Suite (2048-4096)\r\n"
                  "2. Run PQC Benchmark\r\n"
                  "3. Run All\r\n"
+                 "4. Run Single Benchmark (by name)\r\n"
+                 "5. List Benchmarks\r\n"
+                 "6. Toggle Binary Telemetry\r\n"
+                 "7. Run RSA KeyGen (slow)\r\n"
                  "Select option: ";
+    char name[64];
+    int binary_output = 0;
 
-    HAL_UART_Transmit(&huart1, (uint8_t*)menu, strlen(menu), 1000);
+    uart_log_puts(menu);
 
     /* AUTOMATION: Removed hardcoded auto-run to allow script selection */
     /*
-    HAL_UART_Transmit(&huart1, (uint8_t*)"\r\nAuto-starting benchmarks in 2 seconds...\r\n", 42, 1000);
+    uart_log_puts("\r\nAuto-starting benchmarks in 2 seconds...\r\n");
     HAL_Delay(2000);
     benchmark_rsa_suite();
     benchmark_pqc();
-    HAL_UART_Transmit(&huart1, (uint8_t*)"\r\nAuto-execution complete. Entering interactive mode.\r\n", 56, 1000);
+    uart_log_puts("\r\nAuto-execution complete. Entering interactive mode.\r\n");
     */
 
     while (1) {
         /* Check for input with timeout to allow other processing if needed */
         if (HAL_UART_Receive(&huart1, rx_buf, 1, 100) == HAL_OK) {
             /* Echo character */
-            HAL_UART_Transmit(&huart1, rx_buf, 1, 10);
-            HAL_UART_Transmit(&huart1, (uint8_t*)"\r\nExecution Start...\r\n", 20, 100);
+            uart_log_write(rx_buf, 1);
+            uart_log_puts("\r\nExecution Start...\r\n");
 
             switch(rx_buf[0]) {
                 case '1': 
@@ -86,14 +97,63 @@ int main(void)
                     benchmark_pqc(); 
                     benchmark_rsa_suite(); 
                     break;
+                case '4':
+                    uart_log_puts("Benchmark name: ");
+                    if (UART_ReadLine(name, sizeof(name)) > 0 && benchmark_run_by_name(name) == 0) {
+                        uart_log_puts("Unknown benchmark (option 5 lists them)\r\n");
+                    }
+                    break;
+                case '5':
+                    benchmark_list();
+                    break;
+                case '6':
+                    binary_output = !binary_output;
+                    benchmark_set_binary_output(binary_output);
+                    uart_log_puts(binary_output ? "Binary telemetry ON\r\n" : "Binary telemetry OFF\r\n");
+                    break;
+                case '7':
+                    benchmark_rsa_keygen();
+                    break;
                 default: 
-                    HAL_UART_Transmit(&huart1, (uint8_t*)"Invalid option\r\n", 16, 100); 
+                    uart_log_puts("Invalid option\r\n");
                     break;
             }
             /* Reprint menu */
-            HAL_UART_Transmit(&huart1, (uint8_t*)menu, strlen(menu), 1000);
+            uart_log_puts(menu);
+        }
+    }
+}
+
+/* ------------------------------------------------------------------
+ * UART_ReadLine
+ * Blocking, echoing line input terminated by CR or LF (backspace aware).
+ * Returns the number of characters stored (buffer is NUL-terminated).
+ * ----------------------------------------------------------------*/
+static size_t UART_ReadLine(char *buf, size_t len)
+{
+    size_t n = 0;
+    uint8_t c;
+
+    while (1) {
+        if (HAL_UART_Receive(&huart1, &c, 1, HAL_MAX_DELAY) != HAL_OK) {
+            continue;
+        }
+        if (c == '\r' || c == '\n') {
+            break;
+        }
+        if ((c == '\b' || c == 0x7F) && n > 0) {
+            n--;
+            uart_log_puts("\b \b");
+            continue;
+        }
+        if (c >= ' ' && n + 1 < len) {
+            buf[n++] = (char)c;
+            uart_log_write(&c, 1);
         }
     }
+    buf[n] = '\0';
+    uart_log_puts("\r\n");
+    return n;
 }
 
 /* ------------------------------------------------------------------
@@ -195,8 +255,10 @@ static void Error_Handler(void)
 
 /* ------------------------------------------------------------------
  * SysTick_Handler (required for HAL_Delay)
+ * Also samples DWT->CYCCNT so the 64-bit cycle extension never misses a wrap.
  * ----------------------------------------------------------------*/
 void SysTick_Handler(void)
 {
     HAL_IncTick();
+    cycles_poll();
 }
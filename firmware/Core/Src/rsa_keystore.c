@@ -0,0 +1,24 @@
+/**
+ * rsa_keystore.c - Pre-generated RSA keys for the benchmarks
+ * Public/private op benchmarks import these instead of running
+ * mbedtls_rsa_gen_key() (billions of cycles at 4096 bits) first.
+ */
+#include "rsa_keystore.h"
+
+int rsa_keystore_load(mbedtls_rsa_context *rsa, int bits) {
+    for (size_t i = 0; i < rsa_keystore_count; i++) {
+        const rsa_keystore_entry_t *k = &rsa_keystore[i];
+        int ret;
+
+        if (k->bits != bits) {
+            continue;
+        }
+        ret = mbedtls_rsa_import_raw(rsa, k->n, k->n_len, k->p, k->p_len, k->q, k->q_len,
+                                     k->d, k->d_len, k->e, k->e_len);
+        if (ret == 0) {
+            ret = mbedtls_rsa_complete(rsa);
+        }
+        return ret;
+    }
+    return MBEDTLS_ERR_RSA_BAD_INPUT_DATA;
+}
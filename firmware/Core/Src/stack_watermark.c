@@ -45,3 +45,9 @@ size_t stack_watermark_get_usage(void) {
     
     return (size_t)(estack_addr - used_bottom);
 }
+
+size_t stack_watermark_measure(stack_watermark_fn_t fn, void *arg) {
+    stack_watermark_init();
+    fn(arg);
+    return stack_watermark_get_usage();
+}
@@ -0,0 +1,68 @@
+#include "telemetry.h"
+
+uint16_t telemetry_crc16(const uint8_t *data, size_t len) {
+    uint16_t crc = 0xFFFF;
+    for (size_t i = 0; i < len; i++) {
+        crc ^= (uint16_t)data[i] << 8;
+        for (int b = 0; b < 8; b++) {
+            crc = (crc & 0x8000) ? (uint16_t)((crc << 1) ^ 0x1021) : (uint16_t)(crc << 1);
+        }
+    }
+    return crc;
+}
+
+size_t telemetry_cobs_encode(const uint8_t *in, size_t len, uint8_t *out) {
+    size_t code_idx = 0;   /* where the current block's length byte goes */
+    size_t o = 1;
+    uint8_t code = 1;
+
+    for (size_t i = 0; i < len; i++) {
+        if (in[i] == 0) {
+            out[code_idx] = code;
+            code_idx = o++;
+            code = 1;
+        } else {
+            out[o++] = in[i];
+            if (++code == 0xFF) {
+                out[code_idx] = code;
+                code_idx = o++;
+                code = 1;
+            }
+        }
+    }
+    out[code_idx] = code;
+    return o;
+}
+
+static uint8_t *put_le(uint8_t *p, uint64_t v, int bytes) {
+    for (int i = 0; i < bytes; i++) {
+        *p++ = (uint8_t)(v >> (8 * i));
+    }
+    return p;
+}
+
+size_t telemetry_encode(const telemetry_record_t *rec, uint8_t *out) {
+    uint8_t raw[TELEMETRY_PAYLOAD_LEN + 2];
+    uint8_t *p = raw;
+    size_t n;
+
+    *p++ = TELEMETRY_VERSION;
+    *p++ = rec->alg_id;
+    *p++ = rec->op_id;
+    *p++ = rec->flags;
+    p = put_le(p, rec->iteration, 2);
+    p = put_le(p, rec->cycles, 8);
+    p = put_le(p, rec->stack, 4);
+    p = put_le(p, rec->heap, 4);
+    p = put_le(p, rec->allocs, 2);
+    p = put_le(p, rec->frees, 2);
+    p = put_le(p, rec->alloc_cycles, 4);
+    p = put_le(p, rec->alloc_worst, 4);
+    put_le(p, telemetry_crc16(raw, TELEMETRY_PAYLOAD_LEN), 2);
+
+    /* Leading delimiter resynchronises the decoder after interleaved text */
+    out[0] = 0x00;
+    n = telemetry_cobs_encode(raw, sizeof(raw), out + 1);
+    out[1 + n] = 0x00;
+    return n + 2;
+}
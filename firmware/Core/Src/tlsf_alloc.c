@@ -0,0 +1,378 @@
+/**
+ * tlsf_alloc.c - TLSF allocator (see tlsf_alloc.h)
+ * Every block starts with a two-word header: the previous physical block
+ * (only valid while that one is free) and the payload size, whose low bits
+ * flag "this block is free" and "previous block is free". Free blocks keep
+ * their list links in the payload. A zero-size used block ends the pool,
+ * so freeing the last block needs no bounds check.
+ */
+#include "tlsf_alloc.h"
+#include "cycles.h"
+#include <string.h>
+
+#define TLSF_ALIGN_LOG2 3
+#define TLSF_ALIGN      ((size_t)1 << TLSF_ALIGN_LOG2)
+#define TLSF_SL_COUNT   (1 << TLSF_SL_LOG2)
+#define TLSF_FL_SHIFT   (TLSF_SL_LOG2 + TLSF_ALIGN_LOG2)
+#define TLSF_FL_COUNT   (TLSF_FL_MAX - TLSF_FL_SHIFT + 1)
+#define TLSF_SMALL      ((size_t)1 << TLSF_FL_SHIFT)   /* below: one list per 8 bytes */
+
+#define BLOCK_FREE      ((size_t)1)
+#define BLOCK_PREV_FREE ((size_t)2)
+#define BLOCK_FLAGS     (BLOCK_FREE | BLOCK_PREV_FREE)
+
+typedef struct tlsf_block tlsf_block_t;
+struct tlsf_block {
+    tlsf_block_t *prev_phys;
+    size_t size;
+    tlsf_block_t *next_free;    /* payload starts here */
+    tlsf_block_t *prev_free;
+};
+
+#define BLOCK_HDR offsetof(tlsf_block_t, next_free)
+#define BLOCK_MIN (sizeof(tlsf_block_t) - BLOCK_HDR)
+
+static uint32_t fl_bitmap;
+static uint32_t sl_bitmap[TLSF_FL_COUNT];
+static tlsf_block_t *free_lists[TLSF_FL_COUNT][TLSF_SL_COUNT];
+
+static tlsf_block_t *pool_first;        /* NULL until tlsf_alloc_init() */
+static size_t pool_size;
+static uint32_t worst_malloc;
+static uint32_t worst_free;
+
+static inline size_t block_size(const tlsf_block_t *b) {
+    return b->size & ~BLOCK_FLAGS;
+}
+
+static inline void *block_ptr(tlsf_block_t *b) {
+    return (uint8_t *)b + BLOCK_HDR;
+}
+
+static inline tlsf_block_t *block_from_ptr(void *ptr) {
+    return (tlsf_block_t *)((uint8_t *)ptr - BLOCK_HDR);
+}
+
+static inline tlsf_block_t *block_next(tlsf_block_t *b) {
+    return (tlsf_block_t *)((uint8_t *)block_ptr(b) + block_size(b));
+}
+
+/* Index of the highest / lowest set bit; x != 0 */
+static inline int fls_u32(uint32_t x) {
+    return 31 - __builtin_clz(x);
+}
+
+static inline int ffs_u32(uint32_t x) {
+    return __builtin_ctz(x);
+}
+
+/* List that holds blocks of exactly this size (size < 2^TLSF_FL_MAX) */
+static void mapping_insert(size_t size, int *fl, int *sl) {
+    if (size < TLSF_SMALL) {
+        *fl = 0;
+        *sl = (int)(size >> TLSF_ALIGN_LOG2);
+    } else {
+        int f = fls_u32((uint32_t)size);
+        *sl = (int)(size >> (f - TLSF_SL_LOG2)) ^ TLSF_SL_COUNT;
+        *fl = f - (TLSF_FL_SHIFT - 1);
+    }
+}
+
+/* First list whose every block fits the request: round up to the next list */
+static void mapping_search(size_t size, int *fl, int *sl) {
+    if (size >= TLSF_SMALL) {
+        size += ((size_t)1 << (fls_u32((uint32_t)size) - TLSF_SL_LOG2)) - 1;
+    }
+    mapping_insert(size, fl, sl);
+}
+
+/* Non-empty list at or above (fl, sl): two bitmap scans, no list walk */
+static tlsf_block_t *find_suitable(int *fl, int *sl) {
+    uint32_t sl_map = sl_bitmap[*fl] & (~0u << *sl);
+
+    if (sl_map == 0) {
+        uint32_t fl_map = fl_bitmap & (~0u << (*fl + 1));
+        if (fl_map == 0) {
+            return NULL;
+        }
+        *fl = ffs_u32(fl_map);
+        sl_map = sl_bitmap[*fl];
+    }
+    *sl = ffs_u32(sl_map);
+    return free_lists[*fl][*sl];
+}
+
+static void insert_free(tlsf_block_t *b) {
+    int fl, sl;
+    tlsf_block_t *head;
+
+    mapping_insert(block_size(b), &fl, &sl);
+    head = free_lists[fl][sl];
+    b->next_free = head;
+    b->prev_free = NULL;
+    if (head != NULL) {
+        head->prev_free = b;
+    }
+    free_lists[fl][sl] = b;
+    fl_bitmap |= 1u << fl;
+    sl_bitmap[fl] |= 1u << sl;
+}
+
+static void remove_free(tlsf_block_t *b) {
+    int fl, sl;
+    tlsf_block_t *next = b->next_free;
+    tlsf_block_t *prev = b->prev_free;
+
+    mapping_insert(block_size(b), &fl, &sl);
+    if (next != NULL) {
+        next->prev_free = prev;
+    }
+    if (prev != NULL) {
+        prev->next_free = next;
+    } else {
+        free_lists[fl][sl] = next;
+        if (next == NULL) {
+            sl_bitmap[fl] &= ~(1u << sl);
+            if (sl_bitmap[fl] == 0) {
+                fl_bitmap &= ~(1u << fl);
+            }
+        }
+    }
+}
+
+static void *block_alloc(size_t size) {
+    tlsf_block_t *b;
+    size_t bsize;
+    int fl, sl;
+
+    if (pool_first == NULL || size >= ((size_t)1 << TLSF_FL_MAX)) {
+        return NULL;
+    }
+    size = (size + TLSF_ALIGN - 1) & ~(TLSF_ALIGN - 1);
+    if (size < BLOCK_MIN) {
+        size = BLOCK_MIN;
+    }
+    mapping_search(size, &fl, &sl);
+    if (fl >= TLSF_FL_COUNT) {
+        return NULL;
+    }
+    b = find_suitable(&fl, &sl);
+    if (b == NULL) {
+        return NULL;
+    }
+    remove_free(b);
+
+    /* Split off the tail if it can hold a block of its own */
+    bsize = block_size(b);
+    if (bsize >= size + BLOCK_HDR + BLOCK_MIN) {
+        tlsf_block_t *rest = (tlsf_block_t *)((uint8_t *)block_ptr(b) + size);
+        rest->size = (bsize - size - BLOCK_HDR) | BLOCK_FREE;
+        b->size = size | (b->size & BLOCK_PREV_FREE);
+        block_next(rest)->prev_phys = rest;
+        insert_free(rest);
+    } else {
+        b->size &= ~BLOCK_FREE;
+        block_next(b)->size &= ~BLOCK_PREV_FREE;
+    }
+    return block_ptr(b);
+}
+
+/* Merges with free neighbours, so no two free blocks are ever adjacent */
+static void block_release(void *ptr) {
+    tlsf_block_t *b = block_from_ptr(ptr);
+    tlsf_block_t *next;
+
+    if (b->size & BLOCK_PREV_FREE) {
+        tlsf_block_t *prev = b->prev_phys;
+        remove_free(prev);
+        prev->size += BLOCK_HDR + block_size(b);
+        b = prev;
+    }
+    next = block_next(b);
+    if (next->size & BLOCK_FREE) {
+        remove_free(next);
+        b->size += BLOCK_HDR + block_size(next);
+        next = block_next(b);
+    }
+    b->size |= BLOCK_FREE;
+    next->prev_phys = b;
+    next->size |= BLOCK_PREV_FREE;
+    insert_free(b);
+}
+
+int tlsf_alloc_init(void *mem, size_t size) {
+    uintptr_t start = ((uintptr_t)mem + TLSF_ALIGN - 1) & ~(uintptr_t)(TLSF_ALIGN - 1);
+    uintptr_t end = ((uintptr_t)mem + size) & ~(uintptr_t)(TLSF_ALIGN - 1);
+    tlsf_block_t *b, *sentinel;
+    size_t payload;
+
+    fl_bitmap = 0;
+    memset(sl_bitmap, 0, sizeof(sl_bitmap));
+    memset(free_lists, 0, sizeof(free_lists));
+    pool_first = NULL;
+    pool_size = 0;
+    worst_malloc = 0;
+    worst_free = 0;
+
+    if (end <= start || end - start < 2 * BLOCK_HDR + BLOCK_MIN) {
+        return -1;
+    }
+    payload = (size_t)(end - start) - 2 * BLOCK_HDR;
+    if (payload >= ((size_t)1 << TLSF_FL_MAX)) {
+        return -1;
+    }
+
+    b = (tlsf_block_t *)start;
+    b->prev_phys = NULL;
+    b->size = payload | BLOCK_FREE;
+    sentinel = block_next(b);
+    sentinel->prev_phys = b;
+    sentinel->size = BLOCK_PREV_FREE;
+    insert_free(b);
+
+    pool_first = b;
+    pool_size = (size_t)(end - start);
+    return 0;
+}
+
+void *tlsf_malloc(size_t size) {
+    uint32_t start = cycles_get();
+    void *ptr = block_alloc(size);
+    uint32_t t = cycles_get() - start;
+
+    if (t > worst_malloc) {
+        worst_malloc = t;
+    }
+    return ptr;
+}
+
+void tlsf_free(void *ptr) {
+    uint32_t start, t;
+
+    if (ptr == NULL) {
+        return;
+    }
+    start = cycles_get();
+    block_release(ptr);
+    t = cycles_get() - start;
+    if (t > worst_free) {
+        worst_free = t;
+    }
+}
+
+void *tlsf_calloc(size_t n, size_t size) {
+    void *ptr;
+
+    if (size != 0 && n > SIZE_MAX / size) {
+        return NULL;
+    }
+    ptr = tlsf_malloc(n * size);
+    if (ptr != NULL) {
+        memset(ptr, 0, n * size);
+    }
+    return ptr;
+}
+
+/* Grows by moving; the copy is the only part that depends on the size */
+void *tlsf_realloc(void *ptr, size_t size) {
+    void *p;
+    size_t old;
+
+    if (ptr == NULL) {
+        return tlsf_malloc(size);
+    }
+    if (size == 0) {
+        tlsf_free(ptr);
+        return NULL;
+    }
+    old = block_size(block_from_ptr(ptr));
+    if (size <= old) {
+        return ptr;
+    }
+    p = tlsf_malloc(size);
+    if (p != NULL) {
+        memcpy(p, ptr, old);
+        tlsf_free(ptr);
+    }
+    return p;
+}
+
+void tlsf_get_stats(tlsf_stats_t *out) {
+    memset(out, 0, sizeof(*out));
+    out->worst_malloc = worst_malloc;
+    out->worst_free = worst_free;
+    if (pool_first == NULL) {
+        return;
+    }
+    out->size = pool_size;
+    for (tlsf_block_t *b = pool_first; block_size(b) != 0; b = block_next(b)) {
+        size_t s = block_size(b);
+        if (b->size & BLOCK_FREE) {
+            out->free += s;
+            out->free_blocks++;
+            if (s > out->largest_free) {
+                out->largest_free = s;
+            }
+        } else {
+            out->used += s;
+        }
+    }
+    if (out->free != 0) {
+        out->frag_permille = (uint32_t)(1000 - (uint64_t)out->largest_free * 1000 / out->free);
+    }
+}
+
+#if defined(PQC_HEAP_TLSF) && !defined(PQC_HOST)
+/* newlib's allocator entry points (nano.specs), so mbedTLS, stdio and
+ * everything else allocate from TLSF. The pool is the ._user_heap region
+ * (STM32F769NIHx_FLASH.ld) that _sbrk() would otherwise hand out. */
+#include <reent.h>
+
+extern uint8_t _end;
+extern uint8_t _eheap;
+
+static void tlsf_heap_ready(void) {
+    if (pool_first == NULL) {
+        tlsf_alloc_init(&_end, (size_t)(&_eheap - &_end));
+    }
+}
+
+void *malloc(size_t size) {
+    tlsf_heap_ready();
+    return tlsf_malloc(size);
+}
+
+void *calloc(size_t n, size_t size) {
+    tlsf_heap_ready();
+    return tlsf_calloc(n, size);
+}
+
+void *realloc(void *ptr, size_t size) {
+    tlsf_heap_ready();
+    return tlsf_realloc(ptr, size);
+}
+
+void free(void *ptr) {
+    tlsf_free(ptr);
+}
+
+void *_malloc_r(struct _reent *r, size_t size) {
+    (void)r;
+    return malloc(size);
+}
+
+void *_calloc_r(struct _reent *r, size_t n, size_t size) {
+    (void)r;
+    return calloc(n, size);
+}
+
+void *_realloc_r(struct _reent *r, void *ptr, size_t size) {
+    (void)r;
+    return realloc(ptr, size);
+}
+
+void _free_r(struct _reent *r, void *ptr) {
+    (void)r;
+    free(ptr);
+}
+#endif /* PQC_HEAP_TLSF && !PQC_HOST */
@@ -0,0 +1,83 @@
+/**
+ * uart_log.c - Non-blocking USART1 output
+ * Thread mode fills a lock-free ring; the USART1 TX-complete interrupt
+ * sends the next contiguous chunk with HAL_UART_Transmit_IT.
+ */
+#include "uart_log.h"
+#include "ring_buffer.h"
+#include "stm32f7xx_hal.h"
+#include <string.h>
+
+extern UART_HandleTypeDef huart1;
+
+static uint8_t log_storage[UART_LOG_BUFFER_SIZE];
+static ring_buffer_t log_rb;
+static volatile size_t tx_inflight;   /* bytes handed to the HAL, 0 = idle */
+
+/* Starts the next chunk if the UART is idle. Caller masks interrupts. */
+static void uart_log_kick(void) {
+    size_t len;
+    const uint8_t *p;
+
+    if (tx_inflight != 0) {
+        return;
+    }
+    p = rb_peek(&log_rb, &len);
+    if (len == 0) {
+        return;
+    }
+    if (len > 0xFFFF) {
+        len = 0xFFFF;
+    }
+    tx_inflight = len;
+    if (HAL_UART_Transmit_IT(&huart1, p, (uint16_t)len) != HAL_OK) {
+        tx_inflight = 0;
+    }
+}
+
+static void uart_log_kick_from_thread(void) {
+    uint32_t primask = __get_PRIMASK();
+    __disable_irq();
+    uart_log_kick();
+    __set_PRIMASK(primask);
+}
+
+void uart_log_init(void) {
+    rb_init(&log_rb, log_storage, sizeof(log_storage));
+    tx_inflight = 0;
+    HAL_NVIC_SetPriority(USART1_IRQn, 5, 0);
+    HAL_NVIC_EnableIRQ(USART1_IRQn);
+}
+
+void uart_log_write(const uint8_t *data, size_t len) {
+    while (len > 0) {
+        size_t n = rb_write(&log_rb, data, len);
+        data += n;
+        len -= n;
+        uart_log_kick_from_thread();
+    }
+}
+
+void uart_log_puts(const char *s) {
+    uart_log_write((const uint8_t *)s, strlen(s));
+}
+
+void uart_log_flush(void) {
+    while (rb_used(&log_rb) != 0 || tx_inflight != 0) {
+        uart_log_kick_from_thread();
+    }
+}
+
+/* HAL weak callback: previous chunk fully shifted out (TC) */
+void HAL_UART_TxCpltCallback(UART_HandleTypeDef *huart) {
+    if (huart != &huart1) {
+        return;
+    }
+    rb_consume(&log_rb, tx_inflight);
+    tx_inflight = 0;
+    uart_log_kick();
+}
+
+void USART1_IRQHandler(void) {
+    HAL_UART_IRQHandler(&huart1);
+}
@@ -0,0 +1,32 @@
+/**
+ * stm32f7xx_hal.h - Host shim for the STM32 HAL (pqc_demo_host only)
+ * Provides just enough of the HAL for the benchmark harness: the UART
+ * handle type, a HAL_UART_Transmit that writes to stdout and no-op cache
+ * maintenance.
+ */
+#ifndef STM32F7XX_HAL_H_HOST
+#define STM32F7XX_HAL_H_HOST
+
+#include <stdint.h>
+#include <stddef.h>
+
+typedef enum {
+    HAL_OK      = 0x00U,
+    HAL_ERROR   = 0x01U,
+    HAL_BUSY    = 0x02U,
+    HAL_TIMEOUT = 0x03U
+} HAL_StatusTypeDef;
+
+#define HAL_MAX_DELAY 0xFFFFFFFFU
+
+typedef struct {
+    int fd;     /* unused, the shim always writes to stdout */
+} UART_HandleTypeDef;
+
+/* The host has no software-controlled caches; cold mode measures as warm */
+static inline void SCB_CleanInvalidateDCache(void) {}
+static inline void SCB_InvalidateICache(void) {}
+
+HAL_StatusTypeDef HAL_UART_Transmit(UART_HandleTypeDef *huart, const uint8_t *pData, uint16_t Size, uint32_t Timeout);
+
+#endif /* STM32F7XX_HAL_H_HOST */
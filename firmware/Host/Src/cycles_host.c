@@ -0,0 +1,43 @@
+/**
+ * cycles_host.c - Host implementation of cycles.h
+ * x86 uses the time-stamp counter (rdtsc); other hosts fall back to
+ * CLOCK_MONOTONIC nanoseconds. Both are 64-bit, so no wrap handling is
+ * needed and cycles_poll() is a no-op.
+ */
+#include "cycles.h"
+#include <time.h>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+
+static uint64_t cycles_base;
+
+static uint64_t cycles_raw(void) {
+#if defined(__x86_64__) || defined(__i386__)
+    return __rdtsc();
+#else
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000u + (uint64_t)ts.tv_nsec;
+#endif
+}
+
+void cycles_init(void) {
+    cycles_reset();
+}
+
+void cycles_reset(void) {
+    cycles_base = cycles_raw();
+}
+
+uint32_t cycles_get(void) {
+    return (uint32_t)cycles_get64();
+}
+
+uint64_t cycles_get64(void) {
+    return cycles_raw() - cycles_base;
+}
+
+void cycles_poll(void) {
+}
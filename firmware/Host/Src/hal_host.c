@@ -0,0 +1,19 @@
+/**
+ * hal_host.c - STM32 HAL shim for the host build
+ * UART output goes to stdout so benchmark logs can be piped into the
+ * same report scripts used for the board.
+ */
+#include "stm32f7xx_hal.h"
+#include <stdio.h>
+
+UART_HandleTypeDef huart1;
+
+HAL_StatusTypeDef HAL_UART_Transmit(UART_HandleTypeDef *huart, const uint8_t *pData, uint16_t Size, uint32_t Timeout)
+{
+    (void)huart; (void)Timeout;
+    if (fwrite(pData, 1, Size, stdout) != Size) {
+        return HAL_ERROR;
+    }
+    fflush(stdout);
+    return HAL_OK;
+}
@@ -0,0 +1,67 @@
+/**
+ * host_main.c - Entry point of pqc_demo_host
+ *
+ *   pqc_demo_host                      run PQC + RSA suites (menu option 3)
+ *   pqc_demo_host --pqc | --rsa        run one suite
+ *   pqc_demo_host --rsa-keygen         RSA key generation (menu option 7)
+ *   pqc_demo_host --list               list registered benchmarks
+ *   pqc_demo_host "ML-KEM-512 Encaps"  run benchmarks by name
+ *   pqc_demo_host --binary ...         emit binary telemetry records
+ *
+ * Output uses the same UART record format as the board, so logs can be
+ * fed to scripts/generate_report.py and scripts/update_report.py.
+ */
+#include <stdio.h>
+#include <string.h>
+#include "cycles.h"
+#include "crypto_harness.h"
+#include "uart_log.h"
+#include "heap_stats.h"
+#include "tlsf_alloc.h"
+
+#if defined(PQC_HEAP_TLSF)
+/* Stands in for ._user_heap (_Min_Heap_Size); the host libc keeps its own
+ * malloc, so only the mbedTLS allocations go through TLSF here */
+static uint64_t host_heap[0x30000 / sizeof(uint64_t)];
+#endif
+
+int main(int argc, char **argv)
+{
+    int status = 0;
+
+    cycles_init();
+    uart_log_init();
+    heap_stats_init();
+#if defined(PQC_HEAP_TLSF)
+    tlsf_alloc_init(host_heap, sizeof(host_heap));
+    heap_stats_set_backend(tlsf_calloc, tlsf_free);
+#endif
+
+    if (argc < 2 || (argc == 2 && strcmp(argv[1], "--binary") == 0)) {
+        benchmark_set_binary_output(argc == 2);
+        benchmark_pqc();
+        benchmark_rsa_suite();
+        uart_log_flush();
+        return 0;
+    }
+
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--binary") == 0) {
+            benchmark_set_binary_output(1);
+        } else if (strcmp(argv[i], "--list") == 0) {
+            benchmark_list();
+        } else if (strcmp(argv[i], "--pqc") == 0) {
+            benchmark_pqc();
+        } else if (strcmp(argv[i], "--rsa") == 0) {
+            benchmark_rsa_suite();
+        } else if (strcmp(argv[i], "--rsa-keygen") == 0) {
+            benchmark_rsa_keygen();
+        } else if (benchmark_run_by_name(argv[i]) == 0) {
+            uart_log_flush();
+            fprintf(stderr, "Unknown benchmark: %s (use --list)\n", argv[i]);
+            status = 1;
+        }
+    }
+    uart_log_flush();
+    return status;
+}
@@ -0,0 +1,35 @@
+/**
+ * pqm4_compat.c - pqm4 entry points for the host build
+ * crypto_harness.c calls the un-namespaced pqm4 API for ML-KEM-512 and
+ * ML-DSA-44. pqm4 is Cortex-M assembly, so on the host these forward to
+ * the PQClean clean implementations of the same parameter sets.
+ */
+#include <stdint.h>
+#include <stddef.h>
+#include "deps/PQClean/crypto_kem/ml-kem-512/clean/api.h"
+#include "deps/PQClean/crypto_sign/ml-dsa-44/clean/api.h"
+
+int crypto_kem_keypair(uint8_t *pk, uint8_t *sk) {
+    return PQCLEAN_MLKEM512_CLEAN_crypto_kem_keypair(pk, sk);
+}
+
+int crypto_kem_enc(uint8_t *ct, uint8_t *ss, const uint8_t *pk) {
+    return PQCLEAN_MLKEM512_CLEAN_crypto_kem_enc(ct, ss, pk);
+}
+
+int crypto_kem_dec(uint8_t *ss, const uint8_t *ct, const uint8_t *sk) {
+    return PQCLEAN_MLKEM512_CLEAN_crypto_kem_dec(ss, ct, sk);
+}
+
+int crypto_sign_keypair(uint8_t *pk, uint8_t *sk) {
+    return PQCLEAN_MLDSA44_CLEAN_crypto_sign_keypair(pk, sk);
+}
+
+int crypto_sign_signature_ctx(uint8_t *sig, size_t *siglen, const uint8_t *m, size_t mlen,
+                              const uint8_t *ctx, size_t ctxlen, const uint8_t *sk) {
+    return PQCLEAN_MLDSA44_CLEAN_crypto_sign_signature_ctx(sig, siglen, m, mlen, ctx, ctxlen, sk);
+}
+
+int crypto_sign_verify(const uint8_t *sig, size_t siglen, const uint8_t *m, size_t mlen, const uint8_t *pk) {
+    return PQCLEAN_MLDSA44_CLEAN_crypto_sign_verify(sig, siglen, m, mlen, pk);
+}
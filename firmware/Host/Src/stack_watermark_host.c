@@ -0,0 +1,74 @@
+/**
+ * stack_watermark_host.c - Host implementation of stack_watermark.h
+ * Each measurement runs on a dedicated mmap'd stack that is painted with
+ * the same 0xDEADBEEF pattern as on the board. A PROT_NONE guard page
+ * below the stack turns an overflow into a crash instead of a bad number.
+ */
+#define _GNU_SOURCE
+#include "stack_watermark.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <sys/mman.h>
+#include <ucontext.h>
+#include <unistd.h>
+
+/* Generous compared to the 96KB board stack; clean C PQC needs more on x86-64 */
+#ifndef STACK_WATERMARK_HOST_SIZE
+#define STACK_WATERMARK_HOST_SIZE (1024u * 1024u)
+#endif
+
+static uint32_t *stack_lo;           /* lowest usable word (above the guard) */
+static uint32_t *stack_hi;           /* one past the highest word */
+static ucontext_t caller_ctx, run_ctx;
+static stack_watermark_fn_t run_fn;
+static void *run_arg;
+
+void stack_watermark_init(void) {
+    for (uint32_t *curr = stack_lo; curr < stack_hi; curr++) {
+        *curr = 0xDEADBEEF;
+    }
+}
+
+size_t stack_watermark_get_usage(void) {
+    uint32_t *curr = stack_lo;
+    while (curr < stack_hi && *curr == 0xDEADBEEF) {
+        curr++;
+    }
+    return (size_t)((uintptr_t)stack_hi - (uintptr_t)curr);
+}
+
+static void stack_watermark_trampoline(void) {
+    run_fn(run_arg);
+}
+
+size_t stack_watermark_measure(stack_watermark_fn_t fn, void *arg) {
+    size_t page = (size_t)sysconf(_SC_PAGESIZE);
+    size_t total = STACK_WATERMARK_HOST_SIZE + page;
+    size_t used;
+    uint8_t *base;
+
+    base = mmap(NULL, total, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (base == MAP_FAILED) {
+        perror("stack_watermark: mmap");
+        exit(1);
+    }
+    mprotect(base, page, PROT_NONE);
+
+    stack_lo = (uint32_t *)(base + page);
+    stack_hi = (uint32_t *)(base + total);
+    stack_watermark_init();
+
+    run_fn = fn;
+    run_arg = arg;
+    getcontext(&run_ctx);
+    run_ctx.uc_stack.ss_sp = stack_lo;
+    run_ctx.uc_stack.ss_size = STACK_WATERMARK_HOST_SIZE;
+    run_ctx.uc_link = &caller_ctx;
+    makecontext(&run_ctx, stack_watermark_trampoline, 0);
+    swapcontext(&caller_ctx, &run_ctx);
+
+    used = stack_watermark_get_usage();
+    munmap(base, total);
+    stack_lo = stack_hi = NULL;
+    return used;
+}
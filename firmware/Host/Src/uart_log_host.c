@@ -0,0 +1,42 @@
+/**
+ * uart_log_host.c - Host implementation of uart_log.h
+ * Uses the same ring buffer as the board; the consumer side runs inline
+ * and drains to stdout through the HAL_UART_Transmit shim.
+ */
+#include "uart_log.h"
+#include "ring_buffer.h"
+#include "stm32f7xx_hal.h"
+#include <string.h>
+
+extern UART_HandleTypeDef huart1;
+
+static uint8_t log_storage[UART_LOG_BUFFER_SIZE];
+static ring_buffer_t log_rb = { log_storage, UART_LOG_BUFFER_SIZE, 0, 0 };
+
+void uart_log_init(void) {
+    rb_init(&log_rb, log_storage, sizeof(log_storage));
+}
+
+void uart_log_write(const uint8_t *data, size_t len) {
+    while (len > 0) {
+        size_t n = rb_write(&log_rb, data, len);
+        data += n;
+        len -= n;
+        if (len > 0) {
+            uart_log_flush();
+        }
+    }
+}
+
+void uart_log_puts(const char *s) {
+    uart_log_write((const uint8_t *)s, strlen(s));
+}
+
+void uart_log_flush(void) {
+    size_t len;
+    const uint8_t *p;
+    while ((p = rb_peek(&log_rb, &len)), len > 0) {
+        HAL_UART_Transmit(&huart1, p, (uint16_t)len, HAL_MAX_DELAY);
+        rb_consume(&log_rb, len);
+    }
+}
@@ -0,0 +1,43 @@
+/**
+ * stm32f7xx.h - Fake CMSIS device header for test_cycles
+ * Core/Src/cycles.c is built unchanged against these stand-ins, so the
+ * test can set DWT->CYCCNT to any value and watch the 64-bit extension.
+ */
+#ifndef STM32F7XX_H
+#define STM32F7XX_H
+
+#include <stdint.h>
+
+typedef struct {
+    volatile uint32_t CTRL;
+    volatile uint32_t CYCCNT;
+    volatile uint32_t LAR;
+} DWT_Type;
+
+typedef struct {
+    volatile uint32_t DEMCR;
+} CoreDebug_Type;
+
+extern DWT_Type test_dwt;
+extern CoreDebug_Type test_core_debug;
+extern uint32_t test_primask;
+
+#define DWT       (&test_dwt)
+#define CoreDebug (&test_core_debug)
+
+#define CoreDebug_DEMCR_TRCENA_Msk (1UL << 24)
+#define DWT_CTRL_CYCCNTENA_Msk     (1UL)
+
+static inline uint32_t __get_PRIMASK(void) {
+    return test_primask;
+}
+
+static inline void __set_PRIMASK(uint32_t primask) {
+    test_primask = primask;
+}
+
+static inline void __disable_irq(void) {
+    test_primask = 1;
+}
+
+#endif /* STM32F7XX_H */
@@ -0,0 +1,42 @@
+/**
+ * host_test.h - Minimal checks for the host unit tests (Host/Tests)
+ * CHECK() reports the failing expression with file and line and keeps
+ * going; a test's main() returns test_result(), which is 1 if any failed.
+ */
+#ifndef HOST_TEST_H
+#define HOST_TEST_H
+
+#include <stdio.h>
+
+static int test_failures;
+static int test_checks;
+
+#define CHECK(cond) \
+    do { \
+        test_checks++; \
+        if (!(cond)) { \
+            test_failures++; \
+            printf("FAIL: %s:%d: %s\n", __FILE__, __LINE__, #cond); \
+        } \
+    } while (0)
+
+/* Deterministic xorshift, same generator as Tools/bignum_diff.c */
+static unsigned long long test_rng_state = 0x5EEDull;
+
+static inline unsigned test_rand(void) {
+    test_rng_state ^= test_rng_state << 13;
+    test_rng_state ^= test_rng_state >> 7;
+    test_rng_state ^= test_rng_state << 17;
+    return (unsigned)(test_rng_state >> 32);
+}
+
+static inline int test_result(const char *name) {
+    if (test_failures) {
+        printf("%s: %d of %d checks failed\n", name, test_failures, test_checks);
+        return 1;
+    }
+    printf("OK: %s, %d checks\n", name, test_checks);
+    return 0;
+}
+
+#endif /* HOST_TEST_H */
@@ -0,0 +1,252 @@
+/**
+ * test_arena_alloc.c - Unit tests of the bump allocator (arena_alloc.c)
+ *
+ * Checks the fill level after each call: a free of the top block gives its
+ * memory back together with any freed blocks right below it, other frees
+ * wait. Also covers zeroing and alignment, exhaustion, arena_reset() and
+ * the high-water mark, and a random run against a stack model of the
+ * blocks.
+ *
+ *   ./build-host/Host/test_arena_alloc
+ */
+#include "arena_alloc.h"
+#include "host_test.h"
+#include <string.h>
+
+#define HDR 8u      /* block header */
+
+static uint64_t pool[4096 / 8];
+
+static size_t used(void) {
+    arena_stats_t st;
+    arena_get(&st);
+    return st.used;
+}
+
+static size_t peak(void) {
+    arena_stats_t st;
+    arena_get(&st);
+    return st.peak;
+}
+
+static uint32_t failed(void) {
+    arena_stats_t st;
+    arena_get(&st);
+    return st.failed;
+}
+
+static void init(size_t size) {
+    memset(pool, 0xA5, sizeof(pool));
+    arena_alloc_init(pool, size);
+}
+
+static void test_empty(void) {
+    arena_stats_t st;
+
+    init(sizeof(pool));
+    arena_get(&st);
+    CHECK(st.size == sizeof(pool));
+    CHECK(st.used == 0 && st.peak == 0 && st.failed == 0);
+    arena_free(NULL);
+    CHECK(used() == 0);
+}
+
+/* Sizes round up to 8 bytes, blocks are zeroed and 8-byte aligned */
+static void test_alloc(void) {
+    uint8_t *a, *b, *c;
+    int nonzero = 0;
+
+    init(sizeof(pool));
+    a = arena_calloc(1, 10);
+    CHECK(a == (uint8_t *)pool + HDR);
+    CHECK(used() == HDR + 16);
+    b = arena_calloc(3, 4);
+    CHECK(b == a + 16 + HDR);
+    CHECK(used() == 2 * HDR + 32);
+    c = arena_calloc(0, 4);             /* header only */
+    CHECK(c == b + 16 + HDR);
+    CHECK(used() == 3 * HDR + 32);
+
+    for (size_t i = 0; i < 16; i++) {
+        nonzero += a[i] != 0 || b[i] != 0;
+    }
+    CHECK(nonzero == 0);
+    CHECK(((uintptr_t)a | (uintptr_t)b | (uintptr_t)c) % 8 == 0);
+}
+
+/* Frees in reverse order lower the top each time */
+static void test_lifo(void) {
+    void *a, *b, *c;
+
+    init(sizeof(pool));
+    a = arena_calloc(1, 24);
+    b = arena_calloc(1, 40);
+    c = arena_calloc(1, 8);
+    CHECK(used() == 3 * HDR + 72);
+    arena_free(c);
+    CHECK(used() == 2 * HDR + 64);
+    arena_free(b);
+    CHECK(used() == HDR + 24);
+    arena_free(a);
+    CHECK(used() == 0);
+    CHECK(peak() == 3 * HDR + 72);
+
+    /* The space comes back at the same address */
+    CHECK(arena_calloc(1, 24) == a);
+}
+
+/* Frees below the top wait; the top free then pops through every freed
+ * block down to the highest live one */
+static void test_out_of_order(void) {
+    void *a, *b, *c, *d;
+
+    init(sizeof(pool));
+    a = arena_calloc(1, 16);
+    b = arena_calloc(1, 16);
+    c = arena_calloc(1, 16);
+    d = arena_calloc(1, 16);
+    CHECK(used() == 4 * (HDR + 16));
+
+    arena_free(b);
+    arena_free(c);
+    CHECK(used() == 4 * (HDR + 16));
+    arena_free(d);
+    CHECK(used() == HDR + 16);          /* a is still live */
+    CHECK(arena_calloc(1, 16) == b);
+
+    /* Freeing all but the top, in any order, then the top: empty */
+    init(sizeof(pool));
+    a = arena_calloc(1, 8);
+    b = arena_calloc(1, 8);
+    c = arena_calloc(1, 8);
+    arena_free(a);
+    arena_free(b);
+    CHECK(used() == 3 * (HDR + 8));
+    arena_free(c);
+    CHECK(used() == 0);
+
+    /* Freed blocks above a live one are popped when the top goes */
+    a = arena_calloc(1, 8);
+    b = arena_calloc(1, 8);
+    c = arena_calloc(1, 8);
+    d = arena_calloc(1, 8);
+    arena_free(c);
+    arena_free(a);
+    arena_free(d);
+    CHECK(used() == 2 * (HDR + 8));     /* b live, a freed below it */
+    arena_free(b);
+    CHECK(used() == 0);
+}
+
+/* A request that does not fit fails without touching the arena */
+static void test_exhaustion(void) {
+    void *a, *b;
+
+    init(256);
+    a = arena_calloc(1, 256 - 2 * HDR - 16);
+    CHECK(a != NULL);
+    CHECK(used() == 256 - HDR - 16);
+    CHECK(arena_calloc(1, 17) == NULL);          /* rounds to 24 */
+    CHECK(failed() == 1);
+    CHECK(used() == 256 - HDR - 16);
+    b = arena_calloc(1, 16);                     /* exact fit */
+    CHECK(b != NULL);
+    CHECK(used() == 256);
+    CHECK(arena_calloc(0, 0) == NULL);           /* not even a header */
+    CHECK(arena_calloc((size_t)-1 / 2, 4) == NULL);
+    CHECK(failed() == 3);
+    CHECK(peak() == 256);
+
+    arena_free(b);
+    CHECK(arena_calloc(2, 8) == b);
+    CHECK(failed() == 3);
+}
+
+/* arena_reset() empties the arena and keeps the high-water mark;
+ * arena_reset_peak() restarts the mark, arena_alloc_init() clears it */
+static void test_reset(void) {
+    void *a;
+
+    init(sizeof(pool));
+    a = arena_calloc(1, 100);
+    arena_calloc(1, 200);
+    arena_calloc(1, 1000000);
+    CHECK(failed() == 1);
+    arena_reset();
+    CHECK(used() == 0);
+    CHECK(peak() == 2 * HDR + 104 + 200);
+    CHECK(arena_calloc(1, 8) == a);
+    CHECK(used() == HDR + 8);
+
+    arena_reset_peak();
+    CHECK(peak() == HDR + 8);
+    arena_calloc(1, 32);
+    CHECK(peak() == 2 * HDR + 40);
+
+    arena_alloc_init(pool, sizeof(pool));
+    CHECK(used() == 0 && peak() == 0 && failed() == 0);
+}
+
+/* Random calloc/free against a stack of (size, live) blocks */
+#define MODEL_MAX 64
+
+static void test_random(void) {
+    uint8_t *ptr[MODEL_MAX];
+    size_t top[MODEL_MAX];          /* arena top after block i */
+    int live[MODEL_MAX];
+    size_t n = 0, want_peak = 0;
+    int errors = 0;
+
+    init(sizeof(pool));
+    for (int it = 0; it < 200000; it++) {
+        if (n < MODEL_MAX && test_rand() % 2) {
+            size_t size = test_rand() % 64;
+            size_t base = n ? top[n - 1] : 0;
+            uint8_t *p = arena_calloc(1, size);
+
+            if (base + HDR + ((size + 7) & ~(size_t)7) > sizeof(pool)) {
+                errors += p != NULL;
+                continue;
+            }
+            if (p != (uint8_t *)pool + base + HDR) {
+                errors++;
+                break;
+            }
+            for (size_t i = 0; i < size; i++) {
+                errors += p[i] != 0;
+            }
+            memset(p, 0xFF, size);
+            ptr[n] = p;
+            top[n] = base + HDR + ((size + 7) & ~(size_t)7);
+            live[n] = 1;
+            if (top[n] > want_peak) {
+                want_peak = top[n];
+            }
+            n++;
+        } else if (n > 0) {
+            size_t i = test_rand() % n;
+            if (!live[i]) {
+                continue;
+            }
+            arena_free(ptr[i]);
+            live[i] = 0;
+            while (n > 0 && !live[n - 1]) {
+                n--;
+            }
+        }
+        errors += used() != (n ? top[n - 1] : 0);
+    }
+    CHECK(errors == 0);
+    CHECK(peak() == want_peak);
+}
+
+int main(void) {
+    test_empty();
+    test_alloc();
+    test_lifo();
+    test_out_of_order();
+    test_exhaustion();
+    test_reset();
+    test_random();
+    return test_result("test_arena_alloc");
+}
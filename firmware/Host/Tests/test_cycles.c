@@ -0,0 +1,116 @@
+/**
+ * test_cycles.c - Wrap handling of cycles_get64() / cycles_elapsed64()
+ *
+ * Core/Src/cycles.c runs against a fake DWT (Tests/Inc/stm32f7xx.h): the
+ * test moves CYCCNT along a 64-bit reference count, across 0xFFFFFFFF -> 0
+ * and over many wraps, and checks the extended count against it.
+ *
+ *   ./build-host/Host/test_cycles
+ */
+#include "cycles.h"
+#include "host_test.h"
+
+DWT_Type test_dwt;
+CoreDebug_Type test_core_debug;
+uint32_t test_primask;
+
+/* Reference count; CYCCNT is its low word */
+static uint64_t ref;
+
+static void advance(uint64_t n) {
+    ref += n;
+    test_dwt.CYCCNT = (uint32_t)ref;
+}
+
+static void test_init(void) {
+    test_dwt.CYCCNT = 1234;
+    cycles_init();
+    CHECK(test_core_debug.DEMCR & CoreDebug_DEMCR_TRCENA_Msk);
+    CHECK(test_dwt.CTRL & DWT_CTRL_CYCCNTENA_Msk);
+    CHECK(test_dwt.CYCCNT == 0);
+    CHECK(cycles_get64() == 0);
+    CHECK(test_primask == 0);           /* interrupt state restored */
+}
+
+/* Single wrap: 0xFFFFFFF0 -> 0x10 */
+static void test_single_wrap(void) {
+    uint64_t start;
+
+    cycles_reset();
+    ref = 0;
+    advance(0xFFFFFFF0u);
+    start = cycles_get64();
+    CHECK(start == 0xFFFFFFF0u);
+    advance(0x20);
+    CHECK(test_dwt.CYCCNT == 0x10);
+    CHECK(cycles_get64() == 0x100000010ull);
+    CHECK(cycles_elapsed64(start) == 0x20);
+
+    /* Landing exactly on 0 and on 0xFFFFFFFF */
+    advance(0xFFFFFFEFu);
+    CHECK(test_dwt.CYCCNT == 0xFFFFFFFFu);
+    CHECK(cycles_get64() == 0x1FFFFFFFFull);
+    advance(1);
+    CHECK(test_dwt.CYCCNT == 0);
+    CHECK(cycles_get64() == 0x200000000ull);
+}
+
+/* Many wraps with random steps below one period, read by the caller */
+static void test_many_wraps(void) {
+    uint64_t prev, now, start;
+
+    cycles_reset();
+    ref = 0;
+    prev = cycles_get64();
+    start = prev;
+    while (ref < 1000 * 0x100000000ull) {
+        advance(((uint64_t)test_rand() << 2 | 3) & 0xFFFFFFFFu);
+        now = cycles_get64();
+        CHECK(now == ref);
+        CHECK(now > prev);
+        prev = now;
+    }
+    CHECK(cycles_elapsed64(start) == ref);
+}
+
+/* Only the SysTick poll sees the wraps; a late reader still gets it right */
+static void test_poll(void) {
+    cycles_reset();
+    ref = 0;
+    for (int i = 0; i < 40; i++) {
+        advance(0xC0000000u);           /* 0.75 period between polls */
+        cycles_poll();
+    }
+    CHECK(cycles_get64() == ref);
+    CHECK(cycles_get64() == 30 * 0x100000000ull);
+
+    /* Reset clears the extension too */
+    cycles_reset();
+    ref = 0;
+    CHECK(cycles_get64() == 0);
+    advance(5);
+    CHECK(cycles_get64() == 5);
+}
+
+/* cycles_extend() on its own: equal samples are no wrap */
+static void test_extend(void) {
+    cycles_ext_t ext = { 0, 0 };
+
+    CHECK(cycles_extend(&ext, 0) == 0);
+    CHECK(cycles_extend(&ext, 0) == 0);
+    CHECK(cycles_extend(&ext, 0xFFFFFFFFu) == 0xFFFFFFFFull);
+    CHECK(cycles_extend(&ext, 0xFFFFFFFFu) == 0xFFFFFFFFull);
+    CHECK(cycles_extend(&ext, 0) == 0x100000000ull);
+    CHECK(cycles_extend(&ext, 7) == 0x100000007ull);
+    CHECK(cycles_extend(&ext, 6) == 0x200000006ull);
+    CHECK(ext.high == 2);
+}
+
+int main(void) {
+    test_init();
+    test_single_wrap();
+    test_many_wraps();
+    test_poll();
+    test_extend();
+    return test_result("test_cycles");
+}
@@ -0,0 +1,260 @@
+/**
+ * test_ring_buffer.c - Unit tests of the SPSC byte ring (ring_buffer.h)
+ *
+ * Single-threaded cases check the full buffer, partial writes, the
+ * contiguous spans returned by rb_peek() at the end of the storage and the
+ * free-running head/tail counters wrapping past 0xFFFFFFFF. A two-thread
+ * run then streams a byte sequence through a small ring, as the UART ISR
+ * and thread mode do on the board.
+ *
+ *   ./build-host/Host/test_ring_buffer
+ */
+#include "ring_buffer.h"
+#include "host_test.h"
+#include <pthread.h>
+#include <sched.h>
+#include <string.h>
+
+#define RB_SIZE 16u
+
+/* Drains everything readable, span by span, into out; returns the count */
+static size_t drain(ring_buffer_t *rb, uint8_t *out, size_t max) {
+    size_t total = 0, len;
+
+    for (;;) {
+        const uint8_t *p = rb_peek(rb, &len);
+        if (len == 0 || total + len > max) {
+            return total;
+        }
+        memcpy(out + total, p, len);
+        rb_consume(rb, len);
+        total += len;
+    }
+}
+
+static void test_empty(void) {
+    uint8_t storage[RB_SIZE];
+    ring_buffer_t rb;
+    size_t len = 1;
+
+    rb_init(&rb, storage, RB_SIZE);
+    CHECK(rb_used(&rb) == 0);
+    CHECK(rb_free(&rb) == RB_SIZE);
+    CHECK(rb_peek(&rb, &len) == storage);
+    CHECK(len == 0);
+    CHECK(rb_write(&rb, storage, 0) == 0);
+}
+
+/* Every slot is usable; a full ring takes nothing more */
+static void test_full(void) {
+    uint8_t storage[RB_SIZE], in[RB_SIZE + 4], out[RB_SIZE];
+    ring_buffer_t rb;
+    size_t len;
+
+    for (size_t i = 0; i < sizeof(in); i++) {
+        in[i] = (uint8_t)(i + 1);
+    }
+    rb_init(&rb, storage, RB_SIZE);
+    CHECK(rb_write(&rb, in, RB_SIZE) == RB_SIZE);
+    CHECK(rb_used(&rb) == RB_SIZE);
+    CHECK(rb_free(&rb) == 0);
+    CHECK(rb_write(&rb, in, 1) == 0);
+    CHECK(rb_peek(&rb, &len) == storage && len == RB_SIZE);
+
+    /* One byte out, exactly one byte back in */
+    rb_consume(&rb, 1);
+    CHECK(rb_write(&rb, in + RB_SIZE, 4) == 1);
+    CHECK(rb_used(&rb) == RB_SIZE);
+    CHECK(drain(&rb, out, sizeof(out)) == RB_SIZE);
+    CHECK(memcmp(out, in + 1, RB_SIZE) == 0);
+    CHECK(rb_used(&rb) == 0);
+}
+
+/* A write larger than the free space stores the prefix that fits */
+static void test_partial_write(void) {
+    uint8_t storage[RB_SIZE], in[40], out[40];
+    ring_buffer_t rb;
+
+    for (size_t i = 0; i < sizeof(in); i++) {
+        in[i] = (uint8_t)(0xA0 + i);
+    }
+    rb_init(&rb, storage, RB_SIZE);
+    CHECK(rb_write(&rb, in, 10) == 10);
+    CHECK(rb_write(&rb, in + 10, 10) == RB_SIZE - 10);
+    CHECK(rb_free(&rb) == 0);
+    CHECK(drain(&rb, out, sizeof(out)) == RB_SIZE);
+    CHECK(memcmp(out, in, RB_SIZE) == 0);
+
+    /* The caller resubmits the remainder, as uart_log does */
+    CHECK(rb_write(&rb, in + RB_SIZE, 30) == RB_SIZE);
+    CHECK(drain(&rb, out, sizeof(out)) == RB_SIZE);
+    CHECK(memcmp(out, in + RB_SIZE, RB_SIZE) == 0);
+}
+
+/* Data across the end of the storage comes back as two spans */
+static void test_peek_spans(void) {
+    uint8_t storage[RB_SIZE], in[RB_SIZE], tmp[RB_SIZE];
+    ring_buffer_t rb;
+    const uint8_t *p;
+    size_t len;
+
+    for (size_t i = 0; i < sizeof(in); i++) {
+        in[i] = (uint8_t)(0x30 + i);
+    }
+    rb_init(&rb, storage, RB_SIZE);
+    CHECK(rb_write(&rb, tmp, 12) == 12);
+    rb_consume(&rb, 12);                        /* tail at index 12 */
+    CHECK(rb_write(&rb, in, 10) == 10);         /* 4 at the end, 6 wrapped */
+    CHECK(rb_used(&rb) == 10);
+
+    p = rb_peek(&rb, &len);
+    CHECK(p == storage + 12 && len == 4);
+    CHECK(memcmp(p, in, 4) == 0);
+
+    /* A partial consume keeps the rest of the span */
+    rb_consume(&rb, 1);
+    p = rb_peek(&rb, &len);
+    CHECK(p == storage + 13 && len == 3);
+    rb_consume(&rb, 3);
+
+    p = rb_peek(&rb, &len);
+    CHECK(p == storage && len == 6);
+    CHECK(memcmp(p, in + 4, 6) == 0);
+    rb_consume(&rb, 6);
+    p = rb_peek(&rb, &len);
+    CHECK(len == 0);
+
+    /* Ending exactly at the end of the storage: one span, then empty */
+    rb_init(&rb, storage, RB_SIZE);
+    CHECK(rb_write(&rb, tmp, 8) == 8);
+    rb_consume(&rb, 8);
+    CHECK(rb_write(&rb, in, 8) == 8);
+    p = rb_peek(&rb, &len);
+    CHECK(p == storage + 8 && len == 8);
+    rb_consume(&rb, 8);
+    p = rb_peek(&rb, &len);
+    CHECK(p == storage && len == 0);
+}
+
+/* head/tail are free-running; fill level and indices survive their wrap */
+static void test_counter_wrap(void) {
+    uint8_t storage[RB_SIZE], in[RB_SIZE], out[RB_SIZE];
+    ring_buffer_t rb;
+    const uint8_t *p;
+    size_t len;
+
+    for (size_t i = 0; i < sizeof(in); i++) {
+        in[i] = (uint8_t)(0x50 + i);
+    }
+    rb_init(&rb, storage, RB_SIZE);
+    rb.head = rb.tail = 0xFFFFFFF8u;            /* index 8, 8 bytes to 2^32 */
+    CHECK(rb_write(&rb, in, RB_SIZE) == RB_SIZE);
+    CHECK(rb.head == 8);
+    CHECK(rb_used(&rb) == RB_SIZE);
+    CHECK(rb_free(&rb) == 0);
+    CHECK(rb_write(&rb, in, 1) == 0);
+
+    p = rb_peek(&rb, &len);
+    CHECK(p == storage + 8 && len == 8);
+    CHECK(drain(&rb, out, sizeof(out)) == RB_SIZE);
+    CHECK(memcmp(out, in, RB_SIZE) == 0);
+    CHECK(rb.tail == 8 && rb_used(&rb) == 0);
+}
+
+/* Random write/consume sizes against a byte-sequence model */
+static void test_random(void) {
+    uint8_t storage[RB_SIZE], in[RB_SIZE * 2];
+    ring_buffer_t rb;
+    uint32_t produced = 0, consumed = 0;
+    int errors = 0;
+
+    rb_init(&rb, storage, RB_SIZE);
+    rb.head = rb.tail = 0xFFFFF000u;            /* cross the counter wrap too */
+    for (int it = 0; it < 200000; it++) {
+        size_t want = test_rand() % (RB_SIZE + 8), n, len;
+        const uint8_t *p;
+
+        for (size_t i = 0; i < want; i++) {
+            in[i] = (uint8_t)(produced + i);
+        }
+        n = rb_write(&rb, in, want);
+        errors += n != (want < RB_SIZE - (produced - consumed) ? want : RB_SIZE - (produced - consumed));
+        produced += (uint32_t)n;
+
+        p = rb_peek(&rb, &len);
+        errors += len > produced - consumed;
+        len = len ? test_rand() % (len + 1) : 0;
+        for (size_t i = 0; i < len; i++) {
+            errors += p[i] != (uint8_t)(consumed + i);
+        }
+        rb_consume(&rb, len);
+        consumed += (uint32_t)len;
+        errors += rb_used(&rb) != produced - consumed;
+    }
+    CHECK(errors == 0);
+    CHECK(produced > 200000);            /* far past the counter wrap */
+}
+
+/* --- Producer and consumer on two threads --- */
+
+#define STREAM_BYTES (1024u * 1024)
+
+static ring_buffer_t stream_rb;
+static uint8_t stream_storage[64];
+
+static void *producer(void *arg) {
+    uint8_t chunk[23];
+    uint32_t sent = 0;
+
+    (void)arg;
+    while (sent < STREAM_BYTES) {
+        size_t want = 1 + test_rand() % sizeof(chunk), n;
+        if (want > STREAM_BYTES - sent) {
+            want = STREAM_BYTES - sent;
+        }
+        for (size_t i = 0; i < want; i++) {
+            chunk[i] = (uint8_t)((sent + i) * 7);
+        }
+        n = rb_write(&stream_rb, chunk, want);
+        if (n == 0) {
+            sched_yield();          /* full; let the consumer run */
+        }
+        sent += (uint32_t)n;
+    }
+    return NULL;
+}
+
+static void test_threads(void) {
+    pthread_t tid;
+    uint32_t received = 0;
+    int errors = 0;
+
+    rb_init(&stream_rb, stream_storage, sizeof(stream_storage));
+    CHECK(pthread_create(&tid, NULL, producer, NULL) == 0);
+    while (received < STREAM_BYTES) {
+        size_t len;
+        const uint8_t *p = rb_peek(&stream_rb, &len);
+        if (len == 0) {
+            sched_yield();
+        }
+        for (size_t i = 0; i < len; i++) {
+            errors += p[i] != (uint8_t)((received + i) * 7);
+        }
+        rb_consume(&stream_rb, len);
+        received += (uint32_t)len;
+    }
+    pthread_join(tid, NULL);
+    CHECK(errors == 0);
+    CHECK(rb_used(&stream_rb) == 0);
+}
+
+int main(void) {
+    test_empty();
+    test_full();
+    test_partial_write();
+    test_peek_spans();
+    test_counter_wrap();
+    test_random();
+    test_threads();
+    return test_result("test_ring_buffer");
+}
@@ -0,0 +1,429 @@
+/**
+ * test_tlsf_alloc.c - Unit tests of the TLSF allocator (tlsf_alloc.c)
+ *
+ * Every live block is tracked in a shadow table with a fill pattern, so a
+ * block handed out twice, too small or overwritten by the allocator shows
+ * up as a pattern mismatch. After each step the pool must account for
+ * every byte: tlsf_get_stats() used + free + one header per block plus the
+ * sentinel equals the pool size, and no two free blocks may be adjacent
+ * (at most live + 1 of them).
+ *
+ * Cases: split threshold, coalescing with the previous and the next block
+ * up to the end-of-pool sentinel, rounding at first/second-level list
+ * boundaries, exhaustion, and a long random malloc/calloc/realloc/free run.
+ *
+ *   ./build-host/Host/test_tlsf_alloc [iterations] [seed]
+ */
+#include "tlsf_alloc.h"
+#include "host_test.h"
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+/* Layout constants of tlsf_alloc.c: two-word header, 8-byte granularity,
+ * payload at least two words (the free-list links) */
+#define HDR        (2 * sizeof(void *))
+#define BLOCK_MIN  (2 * sizeof(void *))
+#define ALIGN      8u
+#define SMALL      ((size_t)ALIGN << TLSF_SL_LOG2)      /* exact lists below */
+
+#define POOL_BYTES (256u * 1024)
+#define SLOTS      256
+
+static uint64_t pool[POOL_BYTES / sizeof(uint64_t)];
+
+typedef struct {
+    uint8_t *ptr;
+    size_t size;        /* requested */
+    size_t bytes;       /* payload reserved for it, split slack aside */
+    uint8_t tag;
+} shadow_t;
+
+static shadow_t live[SLOTS];
+
+/* Payload the allocator reserves for a request (before any split slack) */
+static size_t block_bytes(size_t size) {
+    size = (size + ALIGN - 1) & ~(size_t)(ALIGN - 1);
+    return size < BLOCK_MIN ? BLOCK_MIN : size;
+}
+
+/* Largest request that is certain to be served by a free block of this
+ * size: the lower bound of its list */
+static size_t list_floor(size_t size) {
+    if (size < SMALL) {
+        return size;
+    }
+    return size & ~(((size_t)1 << (31 - __builtin_clz((uint32_t)size) - TLSF_SL_LOG2)) - 1);
+}
+
+static void fill(uint8_t *p, size_t n, uint8_t tag) {
+    for (size_t i = 0; i < n; i++) {
+        p[i] = (uint8_t)(tag + i * 31);
+    }
+}
+
+static int intact(const uint8_t *p, size_t n, uint8_t tag) {
+    for (size_t i = 0; i < n; i++) {
+        if (p[i] != (uint8_t)(tag + i * 31)) {
+            return 0;
+        }
+    }
+    return 1;
+}
+
+static int in_pool(const void *p, size_t n) {
+    const uint8_t *lo = (const uint8_t *)pool, *hi = lo + sizeof(pool);
+    return (const uint8_t *)p >= lo && (const uint8_t *)p + n <= hi && ((uintptr_t)p & (ALIGN - 1)) == 0;
+}
+
+/* Stats of the pool must add up with the shadow table; returns 1 if so */
+static int pool_consistent(void) {
+    tlsf_stats_t st;
+    size_t n_live = 0, bytes = 0;
+
+    for (int i = 0; i < SLOTS; i++) {
+        if (live[i].ptr) {
+            n_live++;
+            bytes += live[i].bytes;
+            if (!intact(live[i].ptr, live[i].size, live[i].tag)) {
+                return 0;
+            }
+        }
+    }
+    tlsf_get_stats(&st);
+    return st.used + st.free + (n_live + st.free_blocks + 1) * HDR == st.size &&
+           st.free_blocks <= n_live + 1 &&
+           st.used >= bytes && st.used - bytes <= n_live * (HDR + BLOCK_MIN - ALIGN) &&
+           st.largest_free <= st.free &&
+           (st.free == 0 || st.frag_permille == 1000 - st.largest_free * 1000 / st.free);
+}
+
+/* After everything is freed the pool is one block again */
+static int pool_empty(void) {
+    tlsf_stats_t st;
+    tlsf_get_stats(&st);
+    return st.used == 0 && st.free_blocks == 1 && st.free == st.size - 2 * HDR &&
+           st.largest_free == st.free && st.frag_permille == 0;
+}
+
+static void reset(size_t bytes) {
+    memset(live, 0, sizeof(live));
+    CHECK(tlsf_alloc_init(pool, bytes) == 0);
+    CHECK(pool_empty());
+}
+
+static void *track(int slot, size_t size) {
+    uint8_t *p = tlsf_malloc(size);
+    if (p) {
+        live[slot].ptr = p;
+        live[slot].size = size;
+        live[slot].bytes = block_bytes(size);
+        live[slot].tag = (uint8_t)test_rand();
+        fill(p, size, live[slot].tag);
+    }
+    return p;
+}
+
+static void untrack(int slot) {
+    tlsf_free(live[slot].ptr);
+    live[slot].ptr = NULL;
+}
+
+static void test_init(void) {
+    tlsf_stats_t st;
+
+    CHECK(tlsf_alloc_init(pool, HDR) == -1);
+    CHECK(tlsf_malloc(8) == NULL);          /* no pool after a failed init */
+    CHECK(tlsf_alloc_init((uint8_t *)pool + 3, 1000) == 0);
+    tlsf_get_stats(&st);
+    CHECK(st.size % ALIGN == 0 && st.size <= 997);
+    CHECK(pool_empty());
+    reset(sizeof(pool));
+    tlsf_get_stats(&st);
+    CHECK(st.size == sizeof(pool));
+}
+
+/* The tail of a block is split off only if it can hold a block of its own */
+static void test_split(void) {
+    const size_t f = 112;                   /* exact list (< SMALL) */
+    const size_t fit = f - HDR - BLOCK_MIN; /* largest request that splits */
+    tlsf_stats_t before, st;
+    uint8_t *a, *p;
+
+    reset(sizeof(pool));
+    a = track(0, f);
+    track(1, 8);                            /* keeps a off the tail */
+    untrack(0);
+    tlsf_get_stats(&before);
+    CHECK(before.free_blocks == 2);
+
+    p = tlsf_malloc(fit);
+    CHECK(p == a);
+    tlsf_get_stats(&st);
+    CHECK(st.used - before.used == fit);
+    CHECK(st.free_blocks == 2);             /* remainder of BLOCK_MIN bytes */
+    CHECK(st.free == before.free - fit - HDR);
+    tlsf_free(p);
+    tlsf_get_stats(&st);
+    CHECK(st.free_blocks == 2 && st.free == before.free);
+
+    p = tlsf_malloc(fit + ALIGN);
+    CHECK(p == a);
+    tlsf_get_stats(&st);
+    CHECK(st.used - before.used == f);      /* no split: whole block */
+    CHECK(st.free_blocks == 1);
+    tlsf_free(p);
+
+    p = tlsf_malloc(f);
+    CHECK(p == a);
+    tlsf_get_stats(&st);
+    CHECK(st.used - before.used == f && st.free_blocks == 1);
+    tlsf_free(p);
+    CHECK(pool_consistent());
+    untrack(1);
+    CHECK(pool_empty());
+}
+
+/* Coalescing with the previous block, the next block, both, and at the
+ * sentinel that ends the pool */
+static void test_coalesce(void) {
+    tlsf_stats_t st;
+    size_t sz[5];
+    int n = 5;
+
+    reset(sizeof(pool));
+    for (int i = 0; i < 5; i++) {
+        track(i, 64 + 8 * i);
+        sz[i] = block_bytes(64 + 8 * i);
+    }
+    /* Fill the rest so the last block touches the sentinel */
+    for (;;) {
+        tlsf_get_stats(&st);
+        if (st.free_blocks == 0) {
+            break;
+        }
+        CHECK(n < SLOTS && track(n, list_floor(st.largest_free)) != NULL);
+        n++;
+    }
+    CHECK(pool_consistent());
+    CHECK(tlsf_malloc(1) == NULL);
+
+    untrack(0);                             /* first block: no previous */
+    tlsf_get_stats(&st);
+    CHECK(st.free_blocks == 1 && st.free == sz[0]);
+    untrack(1);                             /* previous only */
+    tlsf_get_stats(&st);
+    CHECK(st.free_blocks == 1 && st.free == sz[0] + sz[1] + HDR);
+    untrack(3);
+    tlsf_get_stats(&st);
+    CHECK(st.free_blocks == 2);
+    untrack(2);                             /* previous and next */
+    tlsf_get_stats(&st);
+    CHECK(st.free_blocks == 1 && st.free == sz[0] + sz[1] + sz[2] + sz[3] + 3 * HDR);
+    CHECK(st.largest_free == st.free);
+
+    untrack(n - 1);                         /* last block: next is the sentinel */
+    tlsf_get_stats(&st);
+    CHECK(st.free_blocks == 2);
+    CHECK(pool_consistent());
+    if (n - 2 > 4) {
+        untrack(n - 2);                     /* next only (into the last block) */
+        tlsf_get_stats(&st);
+        CHECK(st.free_blocks == 2);
+    }
+    CHECK(pool_consistent());
+
+    /* The rest in random order */
+    for (int i = n - 1; i > 0; i--) {
+        int j = (int)(test_rand() % (unsigned)(i + 1));
+        shadow_t t = live[i];
+        live[i] = live[j];
+        live[j] = t;
+    }
+    for (int i = 0; i < n; i++) {
+        if (live[i].ptr) {
+            untrack(i);
+            CHECK(pool_consistent());
+        }
+    }
+    CHECK(pool_empty());
+}
+
+/* A request must never get a block from a list whose smallest block is too
+ * small: around every list boundary, an isolated free block of exactly the
+ * list's lower bound L serves requests up to L and no larger */
+static void check_boundary(size_t l) {
+    uint8_t *a, *p;
+    tlsf_stats_t st;
+
+    reset(sizeof(pool));
+    a = track(0, l);
+    CHECK(a != NULL);
+    track(1, 8);
+    untrack(0);
+
+    p = tlsf_malloc(l);
+    CHECK(p == a);
+    tlsf_free(p);
+    p = tlsf_malloc(l - 1);
+    CHECK(p == a);
+    tlsf_free(p);
+
+    p = track(2, l + 1);
+    CHECK(p != NULL && p != a);
+    if (p) {
+        CHECK(pool_consistent());
+        untrack(2);
+    }
+    tlsf_get_stats(&st);
+    CHECK(st.free_blocks == 2);
+    untrack(1);
+    CHECK(pool_empty());
+}
+
+static void test_boundaries(void) {
+    for (size_t l = BLOCK_MIN + ALIGN; l < SMALL; l += ALIGN) {
+        check_boundary(l);
+    }
+    for (int fl = 7; (1u << fl) < POOL_BYTES / 4; fl++) {
+        size_t step = (size_t)1 << (fl - TLSF_SL_LOG2);
+        check_boundary((size_t)1 << fl);                            /* first list */
+        check_boundary(((size_t)1 << fl) + step);
+        check_boundary(((size_t)2 << fl) - step);                   /* last list */
+    }
+}
+
+/* Running out returns NULL and leaves every live block alone */
+static void test_exhaustion(void) {
+    tlsf_stats_t st;
+    int n = 0;
+    uint8_t *p;
+
+    reset(8192);
+    while (n < SLOTS && track(n, 100) != NULL) {
+        n++;
+    }
+    CHECK(n > 10 && n < SLOTS);
+    tlsf_get_stats(&st);
+    CHECK(st.largest_free < block_bytes(100));
+    CHECK(pool_consistent());
+
+    CHECK(tlsf_malloc(1u << TLSF_FL_MAX) == NULL);
+    CHECK(tlsf_malloc(SIZE_MAX) == NULL);
+    CHECK(tlsf_calloc(SIZE_MAX / 2, 4) == NULL);
+    CHECK(tlsf_realloc(live[0].ptr, 4096) == NULL);     /* old block kept */
+    CHECK(pool_consistent());
+
+    /* Every other block free: plenty of bytes, no 240-byte run */
+    for (int i = 0; i < n; i += 2) {
+        untrack(i);
+    }
+    tlsf_get_stats(&st);
+    CHECK(st.frag_permille > 500);
+    CHECK(tlsf_malloc(240) == NULL);
+    p = tlsf_malloc(100);
+    CHECK(p != NULL);
+    tlsf_free(p);
+    CHECK(pool_consistent());
+
+    for (int i = 1; i < n; i += 2) {
+        untrack(i);
+    }
+    CHECK(pool_empty());
+}
+
+static size_t random_size(void) {
+    unsigned r = test_rand() % 100;
+    if (r < 70) {
+        return test_rand() % 257;
+    }
+    if (r < 95) {
+        return 257 + test_rand() % 3840;
+    }
+    return 4097 + test_rand() % 28672;
+}
+
+/* Random malloc/calloc/realloc/free against the shadow table */
+static void test_random(int iterations) {
+    int errors = 0, failed = 0;
+
+    reset(sizeof(pool));
+    for (int it = 0; it < iterations; it++) {
+        int slot = (int)(test_rand() % SLOTS);
+        shadow_t *s = &live[slot];
+        size_t size = random_size();
+
+        if (s->ptr == NULL) {
+            uint8_t *p;
+            if (test_rand() & 1) {
+                p = tlsf_calloc(1, size);
+                for (size_t i = 0; p && i < size; i++) {
+                    errors += p[i] != 0;
+                }
+            } else {
+                p = tlsf_malloc(size);
+            }
+            if (p == NULL) {
+                failed++;
+                continue;
+            }
+            errors += !in_pool(p, size);
+            s->ptr = p;
+            s->size = size;
+            s->bytes = block_bytes(size);
+            s->tag = (uint8_t)test_rand();
+            fill(p, size, s->tag);
+        } else if (test_rand() & 1) {
+            errors += !intact(s->ptr, s->size, s->tag);
+            untrack(slot);
+        } else {
+            /* realloc keeps the common prefix; the tail is refilled */
+            size_t keep = size < s->size ? size : s->size;
+            uint8_t *p = tlsf_realloc(s->ptr, size ? size : 1);
+            if (p == NULL) {
+                failed++;
+                errors += !intact(s->ptr, s->size, s->tag);
+                continue;
+            }
+            errors += !in_pool(p, size) || !intact(p, keep, s->tag);
+            if (p != s->ptr) {
+                s->bytes = block_bytes(size ? size : 1);
+            }                                   /* else shrunk in place */
+            s->ptr = p;
+            s->size = size;
+            fill(p, size, s->tag);
+        }
+        if (it % 1000 == 0) {
+            errors += !pool_consistent();
+        }
+    }
+    CHECK(errors == 0);
+    CHECK(pool_consistent());
+    printf("  random: %d ops, %d refused for lack of space\n", iterations, failed);
+
+    for (int i = 0; i < SLOTS; i++) {
+        if (live[i].ptr) {
+            untrack(i);
+        }
+    }
+    CHECK(pool_empty());
+}
+
+int main(int argc, char **argv) {
+    int iterations = argc > 1 ? atoi(argv[1]) : 200000;
+
+    if (argc > 2) {
+        test_rng_state = strtoull(argv[2], NULL, 0);
+    }
+    if (iterations <= 0 || test_rng_state == 0) {
+        fprintf(stderr, "Usage: %s [iterations] [seed]\n", argv[0]);
+        return 2;
+    }
+    test_init();
+    test_split();
+    test_coalesce();
+    test_boundaries();
+    test_exhaustion();
+    test_random(iterations);
+    return test_result("test_tlsf_alloc");
+}
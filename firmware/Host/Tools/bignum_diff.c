@@ -0,0 +1,310 @@
+/**
+ * bignum_diff.c - Differential check and benchmark: custom BigInt vs mbedtls_mpi
+ *
+ * Random operands (deterministic xorshift, seedable) go through both bignum
+ * stacks; every result is compared byte for byte and each operation is timed
+ * with the host cycle counter (rdtsc):
+ *   modmul     bi_mont_mul (2 products)    vs. mbedtls_mpi_mul_mpi + mod_mpi
+ *   mulmod     bi_mul + bi_mod             vs. (same as modmul)
+ *   modexp     bi_mod_exp (e = 65537)      vs. mbedtls_mpi_exp_mod
+ *   modexp_ct  bi_mod_exp_ct (full-size e) vs. mbedtls_mpi_exp_mod
+ *   modexp_bs  bi_mod_exp_bitserial        vs. (same as modexp)
+ *
+ * modexp_bs is the pre-Montgomery bit-serial baseline; the line after each
+ * size gives its speedup to modexp.
+ *
+ * A second table checks mbedtls_mpi_core_montsqr() against
+ * mbedtls_mpi_core_montmul() with A == B (random operands plus the carry
+ * edge cases A = 0, A = N - 1 and N = 2^bits - 1) and times both.
+ *
+ * mulmod needs the double-length product in one BigInt, so it only runs
+ * while 2 * words <= BI_MAX_WORDS (2048 bits).
+ *
+ *   ./build-host/Host/bignum_diff_host [iterations] [seed]
+ *
+ * Exits with 1 on the first mismatch, after printing the operands.
+ */
+#include "bigint.h"
+#include "cycles.h"
+#include "mbedtls/bignum.h"
+#include "bignum_core.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define DIFF_MAX_BYTES (BI_MAX_WORDS * 4)
+
+static uint64_t rng_state;
+
+static uint32_t rng_next(void) {
+    rng_state ^= rng_state << 13;
+    rng_state ^= rng_state >> 7;
+    rng_state ^= rng_state << 17;
+    return (uint32_t)(rng_state >> 32);
+}
+
+static void rng_bytes(uint8_t *buf, size_t len) {
+    for (size_t i = 0; i < len; i++) {
+        buf[i] = (uint8_t)rng_next();
+    }
+}
+
+/* Per-operation timing: total cycles of each library over all iterations */
+typedef struct {
+    const char *name;
+    uint64_t custom;
+    uint64_t mbed;
+} diff_timing_t;
+
+enum { OP_MODMUL, OP_MULMOD, OP_MODEXP, OP_MODEXP_CT, OP_MODEXP_BS, OP_COUNT };
+
+static void dump(const char *label, const uint8_t *buf, size_t len) {
+    printf("  %-8s ", label);
+    for (size_t i = 0; i < len; i++) {
+        printf("%02x", buf[i]);
+    }
+    printf("\n");
+}
+
+/* Compares a BigInt result with an mbedtls_mpi result as len-byte big-endian */
+static int diff_check(const char *op, int bits, const BigInt *r, const mbedtls_mpi *x,
+                      const uint8_t *ops[], const char *names[], size_t n_ops, size_t len) {
+    uint8_t a[DIFF_MAX_BYTES], b[DIFF_MAX_BYTES];
+
+    bi_to_bytes(r, a, (int)len);
+    if (mbedtls_mpi_write_binary(x, b, len) != 0 || memcmp(a, b, len) != 0) {
+        printf("MISMATCH: %s at %d bits\n", op, bits);
+        for (size_t i = 0; i < n_ops; i++) {
+            dump(names[i], ops[i], len);
+        }
+        dump("bigint", a, len);
+        dump("mbedtls", b, len);
+        return -1;
+    }
+    return 0;
+}
+
+static int diff_run(int bits, int iterations, diff_timing_t *t) {
+    const size_t len = (size_t)bits / 8;
+    uint8_t mb[DIFF_MAX_BYTES], ab[DIFF_MAX_BYTES], bb[DIFF_MAX_BYTES], eb[DIFF_MAX_BYTES];
+    const uint8_t *ops[] = { mb, ab, bb, eb };
+    const char *names[] = { "m", "a", "b", "e" };
+    BigInt m, a, b, e, e65537, r, tmp;
+    bi_mont_ctx ctx;
+    mbedtls_mpi M, A, B, E, E65537, X, T;
+    uint64_t start;
+    int ret = 0;
+
+    if (len == 0 || len > DIFF_MAX_BYTES) {
+        return -1;
+    }
+
+    mbedtls_mpi_init(&M);
+    mbedtls_mpi_init(&A);
+    mbedtls_mpi_init(&B);
+    mbedtls_mpi_init(&E);
+    mbedtls_mpi_init(&E65537);
+    mbedtls_mpi_init(&X);
+    mbedtls_mpi_init(&T);
+    bi_set_uint32(&e65537, 65537);
+    if (mbedtls_mpi_lset(&E65537, 65537) != 0) {
+        ret = -1;
+    }
+
+    for (int it = 0; it < iterations && ret == 0; it++) {
+        /* Odd modulus of exactly `bits` bits; a, b < m; e full length */
+        rng_bytes(mb, len);
+        mb[0] |= 0x80;
+        mb[len - 1] |= 1;
+        rng_bytes(ab, len);
+        ab[0] &= 0x7F;
+        rng_bytes(bb, len);
+        bb[0] &= 0x7F;
+        rng_bytes(eb, len);
+
+        bi_from_bytes(&m, mb, (int)len);
+        bi_from_bytes(&a, ab, (int)len);
+        bi_from_bytes(&b, bb, (int)len);
+        bi_from_bytes(&e, eb, (int)len);
+        if (mbedtls_mpi_read_binary(&M, mb, len) != 0 || mbedtls_mpi_read_binary(&A, ab, len) != 0 ||
+            mbedtls_mpi_read_binary(&B, bb, len) != 0 || mbedtls_mpi_read_binary(&E, eb, len) != 0) {
+            ret = -1;
+            break;
+        }
+
+        /* a * b mod m: Montgomery, (a * b * R^-1) * R^2 * R^-1 */
+        bi_mont_init(&ctx, &m);
+        start = cycles_get64();
+        bi_mont_mul(&tmp, &a, &b, &ctx);
+        bi_mont_mul(&r, &tmp, &ctx.rr, &ctx);
+        t[OP_MODMUL].custom += cycles_get64() - start;
+        start = cycles_get64();
+        ret = mbedtls_mpi_mul_mpi(&T, &A, &B);
+        if (ret == 0) {
+            ret = mbedtls_mpi_mod_mpi(&X, &T, &M);
+        }
+        t[OP_MODMUL].mbed += cycles_get64() - start;
+        if (ret != 0 || diff_check("modmul", bits, &r, &X, ops, names, 3, len) != 0) {
+            ret = -1;
+            break;
+        }
+
+        /* Same product through the full-width multiply and long division */
+        if (2 * m.len <= BI_MAX_WORDS) {
+            start = cycles_get64();
+            bi_mul(&tmp, &a, &b);
+            bi_mod(&r, &tmp, &m);
+            t[OP_MULMOD].custom += cycles_get64() - start;
+            t[OP_MULMOD].mbed = t[OP_MODMUL].mbed;
+            if (diff_check("mulmod", bits, &r, &X, ops, names, 3, len) != 0) {
+                ret = -1;
+                break;
+            }
+        }
+
+        /* a^65537 mod m */
+        start = cycles_get64();
+        bi_mod_exp(&r, &a, &e65537, &m);
+        t[OP_MODEXP].custom += cycles_get64() - start;
+        start = cycles_get64();
+        ret = mbedtls_mpi_exp_mod(&X, &A, &E65537, &M, NULL);
+        t[OP_MODEXP].mbed += cycles_get64() - start;
+        if (ret != 0 || diff_check("modexp", bits, &r, &X, ops, names, 2, len) != 0) {
+            ret = -1;
+            break;
+        }
+
+        /* Same through the bit-serial baseline */
+        start = cycles_get64();
+        bi_mod_exp_bitserial(&r, &a, &e65537, &m);
+        t[OP_MODEXP_BS].custom += cycles_get64() - start;
+        t[OP_MODEXP_BS].mbed = t[OP_MODEXP].mbed;
+        if (diff_check("modexp_bs", bits, &r, &X, ops, names, 2, len) != 0) {
+            ret = -1;
+            break;
+        }
+
+        /* a^e mod m, full-length exponent */
+        start = cycles_get64();
+        bi_mod_exp_ct(&r, &a, &e, &m);
+        t[OP_MODEXP_CT].custom += cycles_get64() - start;
+        start = cycles_get64();
+        ret = mbedtls_mpi_exp_mod(&X, &A, &E, &M, NULL);
+        t[OP_MODEXP_CT].mbed += cycles_get64() - start;
+        if (ret != 0 || diff_check("modexp_ct", bits, &r, &X, ops, names, 4, len) != 0) {
+            ret = -1;
+            break;
+        }
+    }
+
+    mbedtls_mpi_free(&M);
+    mbedtls_mpi_free(&A);
+    mbedtls_mpi_free(&B);
+    mbedtls_mpi_free(&E);
+    mbedtls_mpi_free(&E65537);
+    mbedtls_mpi_free(&X);
+    mbedtls_mpi_free(&T);
+    return ret;
+}
+
+/* mbedtls_mpi_core_montsqr(A) vs. mbedtls_mpi_core_montmul(A, A), same N */
+static int sqr_run(int bits, int iterations, uint64_t *t_sqr, uint64_t *t_mul) {
+    const size_t n = (size_t)bits / biL;
+    mbedtls_mpi_uint N[DIFF_MAX_BYTES / sizeof(mbedtls_mpi_uint)];
+    mbedtls_mpi_uint A[DIFF_MAX_BYTES / sizeof(mbedtls_mpi_uint)];
+    mbedtls_mpi_uint X[DIFF_MAX_BYTES / sizeof(mbedtls_mpi_uint)];
+    mbedtls_mpi_uint Y[DIFF_MAX_BYTES / sizeof(mbedtls_mpi_uint)];
+    mbedtls_mpi_uint T[2 * DIFF_MAX_BYTES / sizeof(mbedtls_mpi_uint) + 1];
+    uint64_t start;
+
+    for (int it = 0; it < iterations; it++) {
+        rng_bytes((uint8_t *)N, n * ciL);
+        if (it == 2) {
+            memset(N, 0xFF, n * ciL);       /* every limb all ones */
+        }
+        N[n - 1] |= (mbedtls_mpi_uint)1 << (biL - 1);
+        N[0] |= 1;
+        if (it == 0) {
+            memcpy(A, N, n * ciL);          /* A = N - 1 */
+            A[0] ^= 1;
+        } else if (it == 1) {
+            memset(A, 0, n * ciL);
+        } else {
+            rng_bytes((uint8_t *)A, n * ciL);
+            A[n - 1] &= N[n - 1] >> 1;      /* A < N */
+        }
+        mbedtls_mpi_uint mm = mbedtls_mpi_core_montmul_init(N);
+
+        start = cycles_get64();
+        mbedtls_mpi_core_montsqr(X, A, N, n, mm, T);
+        *t_sqr += cycles_get64() - start;
+        start = cycles_get64();
+        mbedtls_mpi_core_montmul(Y, A, A, n, N, n, mm, T);
+        *t_mul += cycles_get64() - start;
+
+        if (memcmp(X, Y, n * ciL) != 0) {
+            printf("MISMATCH: montsqr at %d bits\n", bits);
+            dump("n", (const uint8_t *)N, n * ciL);
+            dump("a", (const uint8_t *)A, n * ciL);
+            dump("montsqr", (const uint8_t *)X, n * ciL);
+            dump("montmul", (const uint8_t *)Y, n * ciL);
+            return -1;
+        }
+    }
+    return 0;
+}
+
+int main(int argc, char **argv) {
+    static const int sizes[] = { 2048, 3072, 4096 };
+    int iterations = argc > 1 ? atoi(argv[1]) : 20;
+    unsigned long long seed = argc > 2 ? strtoull(argv[2], NULL, 0) : 0x5EEDull;
+
+    if (iterations <= 0) {
+        fprintf(stderr, "Usage: %s [iterations] [seed]\n", argv[0]);
+        return 2;
+    }
+    rng_state = seed ? seed : 1;
+    cycles_init();
+
+    printf("%-6s %-10s %14s %14s %8s\n", "Bits", "Op", "BigInt (cyc)", "mbedTLS (cyc)", "Ratio");
+    for (size_t s = 0; s < sizeof(sizes) / sizeof(sizes[0]); s++) {
+        diff_timing_t t[OP_COUNT] = {
+            { "modmul", 0, 0 }, { "mulmod", 0, 0 }, { "modexp", 0, 0 }, { "modexp_ct", 0, 0 },
+            { "modexp_bs", 0, 0 },
+        };
+        if (diff_run(sizes[s], iterations, t) != 0) {
+            return 1;
+        }
+        for (int op = 0; op < OP_COUNT; op++) {
+            uint64_t c = t[op].custom / (uint64_t)iterations;
+            uint64_t m = t[op].mbed / (uint64_t)iterations;
+            if (c == 0) {
+                continue;           /* not run at this size */
+            }
+            if (m) {
+                printf("%-6d %-10s %14llu %14llu %7.2fx\n", sizes[s], t[op].name, (unsigned long long)c,
+                       (unsigned long long)m, (double)c / (double)m);
+            } else {
+                printf("%-6d %-10s %14llu %14s %8s\n", sizes[s], t[op].name, (unsigned long long)c, "-", "-");
+            }
+        }
+        printf("%-6d %-10s %7.2fx faster than modexp_bs\n", sizes[s], "modexp",
+               (double)t[OP_MODEXP_BS].custom / (double)t[OP_MODEXP].custom);
+    }
+    printf("\n%-6s %-10s %14s %14s %8s\n", "Bits", "Op", "montsqr (cyc)", "montmul (cyc)", "Ratio");
+    for (size_t s = 0; s < sizeof(sizes) / sizeof(sizes[0]); s++) {
+        /* Half-size moduli too: the CRT exponentiations run mod p and q */
+        for (int half = 1; half >= 0; half--) {
+            int bits = sizes[s] >> half;
+            uint64_t t_sqr = 0, t_mul = 0;
+            if (sqr_run(bits, iterations, &t_sqr, &t_mul) != 0) {
+                return 1;
+            }
+            printf("%-6d %-10s %14llu %14llu %7.2fx\n", bits, "montsqr",
+                   (unsigned long long)(t_sqr / (uint64_t)iterations),
+                   (unsigned long long)(t_mul / (uint64_t)iterations), (double)t_sqr / (double)t_mul);
+        }
+    }
+    printf("OK: %d iterations per size, seed 0x%llx, all results equal\n", iterations, seed);
+    return 0;
+}
@@ -4,23 +4,184 @@
 #include <stdint.h>
 #include <stdbool.h>
 
-#define BI_MAX_WORDS 64 // 64 * 32 = 2048 bits
+#define BI_MAX_WORDS 128 // 128 * 32 = 4096 bits of storage per BigInt
 
+/* Operand sizes with fixed-size (fully unrollable) Montgomery kernels;
+ * other lengths run the same code with a run-time word count */
+#define BI_WORDS_2048 64
+#define BI_WORDS_3072 96
+#define BI_WORDS_4096 128
+
+/* Unroll factor for the inner kernel loops. Set it to the word count
+ * (e.g. 128) for fully unrolled loops, at the cost of flash and I-cache. */
+#ifndef BI_MONT_UNROLL
+#define BI_MONT_UNROLL 8
+#endif
+
+/* Multiply-accumulate through the UMAAL instruction (Cortex-M7 and other
+ * cores with the DSP extension); 0 selects the portable C, which gives
+ * bit-identical results */
+#ifndef BI_USE_UMAAL
+#if defined(__ARM_FEATURE_DSP) && __ARM_FEATURE_DSP
+#define BI_USE_UMAAL 1
+#else
+#define BI_USE_UMAAL 0
+#endif
+#endif
+
+/* bi_mul(): operands of at least this many words use Karatsuba, smaller
+ * ones (and the recursion below it) schoolbook. 32 is the host (x86)
+ * crossover; the "Mul Crossover" harness entry measures it on the target. */
+#ifndef BI_KARATSUBA_THRESHOLD
+#define BI_KARATSUBA_THRESHOLD 32
+#endif
+
+/* bi_mod_exp(): exponents up to BI_EXP_SHORT_BITS use plain square-and-multiply,
+ * longer ones a sliding window of BI_EXP_WINDOW_BITS (2^(w-1) BigInts of stack) */
+#ifndef BI_EXP_SHORT_BITS
+#define BI_EXP_SHORT_BITS 32
+#endif
+#ifndef BI_EXP_WINDOW_BITS
+#define BI_EXP_WINDOW_BITS 5
+#endif
+
+/* bi_mod_exp_ct(): fixed window width (2^w BigInts of stack) */
+#ifndef BI_EXP_CT_WINDOW_BITS
+#define BI_EXP_CT_WINDOW_BITS 4
+#endif
+
+#if BI_EXP_WINDOW_BITS < 1 || BI_EXP_WINDOW_BITS > 7 || BI_EXP_CT_WINDOW_BITS < 1 || BI_EXP_CT_WINDOW_BITS > 6
+#error "BI_EXP_WINDOW_BITS must be 1..7 and BI_EXP_CT_WINDOW_BITS 1..6"
+#endif
+
+/* Value is words[0 .. len-1], least significant word first. Words at and
+ * above len are not part of the value and are never read, so the cost of
+ * every operation follows the operand length, not BI_MAX_WORDS. */
 typedef struct {
     uint32_t words[BI_MAX_WORDS];
+    int len;
 } BigInt;
 
+/* Montgomery context for an odd modulus n of `words` significant words,
+ * R = 2^(32*words) */
+typedef struct {
+    BigInt n;
+    BigInt rr;          /* R^2 mod n */
+    uint32_t n0inv;     /* -n^-1 mod 2^32 */
+    int words;
+} bi_mont_ctx;
+
+/* Barrett context for a modulus n of `words` significant words */
+typedef struct {
+    BigInt n;
+    uint32_t mu[BI_MAX_WORDS + 1]; /* floor(2^(64*words) / n), words + 1 words */
+    int words;
+} bi_barrett_ctx;
+
+/* Reduction strategy of a bi_mod_ctx. Montgomery needs an odd modulus and
+ * a conversion into and out of its domain per exponentiation; Barrett works
+ * on plain residues but costs about one extra half product per multiply. */
+typedef enum {
+    BI_REDUCE_MONTGOMERY = 0,
+    BI_REDUCE_BARRETT    = 1,
+} bi_reduce_t;
+
+/* Per-modulus context; only the member of the chosen strategy is set up */
+typedef struct {
+    bi_reduce_t strategy;
+    bi_mont_ctx mont;
+    bi_barrett_ctx barrett;
+} bi_mod_ctx;
+
 void bi_from_bytes(BigInt* a, const uint8_t* buf, int len);
-void bi_to_bytes(const BigInt* a, uint8_t* buf, int len);
+void bi_to_bytes(const BigInt* a, uint8_t* buf, int len); // Big-endian, zero-padded to len bytes
 void bi_set_uint32(BigInt* a, uint32_t val);
+void bi_resize(BigInt* a, int words); // Zero-extends, or truncates to the low words
 
 void bi_copy(BigInt* dst, const BigInt* src);
 int bi_compare(const BigInt* a, const BigInt* b);
 
-void bi_add(BigInt* r, const BigInt* a, const BigInt* b);
-void bi_sub(BigInt* r, const BigInt* a, const BigInt* b);
-void bi_mul(BigInt* r, const BigInt* a, const BigInt* b); // Simple schoolbook
-void bi_mod_mul(BigInt* r, const BigInt* a, const BigInt* b, const BigInt* m);
+void bi_add(BigInt* r, const BigInt* a, const BigInt* b); // Grows by one word on carry
+void bi_sub(BigInt* r, const BigInt* a, const BigInt* b); // Requires a >= b
+
+/**
+ * @brief  Full product r = a * b, a->len + b->len words long (truncated to
+ *         BI_MAX_WORDS). Karatsuba while both operands have at least
+ *         BI_KARATSUBA_THRESHOLD words, schoolbook below. r may alias a or b.
+ */
+void bi_mul(BigInt* r, const BigInt* a, const BigInt* b);
+
+/**
+ * @brief  bi_mul() with an explicit threshold; a threshold above both
+ *         lengths gives plain schoolbook. Used for the crossover sweep.
+ */
+void bi_mul_karatsuba(BigInt* r, const BigInt* a, const BigInt* b, int threshold);
+void bi_mod_mul(BigInt* r, const BigInt* a, const BigInt* b, const BigInt* m); // Bit-serial, any m
+
+/**
+ * @brief  r = a mod m by long division (Knuth Algorithm D), any m > 0.
+ *         The result has m's significant word count. Variable time.
+ */
+void bi_mod(BigInt* r, const BigInt* a, const BigInt* m);
+
+/**
+ * @brief  Precomputes n0' and R^2 mod m. m must be odd.
+ */
+void bi_mont_init(bi_mont_ctx* ctx, const BigInt* m);
+
+/**
+ * @brief  Montgomery product r = a * b * R^-1 mod n (CIOS).
+ *         a, b < R and at least ctx->words long (bi_resize()); the result
+ *         is fully reduced and ctx->words long. r may alias a or b.
+ *         2048/3072/4096-bit moduli use fixed-size specialisations.
+ */
+void bi_mont_mul(BigInt* r, const BigInt* a, const BigInt* b, const bi_mont_ctx* ctx);
+
+/**
+ * @brief  Precomputes mu = floor(2^(64k) / m) for k-word m (any m > 0).
+ */
+void bi_barrett_init(bi_barrett_ctx* ctx, const BigInt* m);
+
+/**
+ * @brief  r = a * b mod n by Barrett reduction. a, b < n and at least
+ *         ctx->words long; the result is ctx->words long. r may alias a or b.
+ */
+void bi_barrett_mul(BigInt* r, const BigInt* a, const BigInt* b, const bi_barrett_ctx* ctx);
+
+/**
+ * @brief  Sets up the context of one modulus for the given strategy
+ *         (Montgomery: m must be odd).
+ */
+void bi_mod_ctx_init(bi_mod_ctx* ctx, const BigInt* m, bi_reduce_t strategy);
+
+/**
+ * @brief  r = b^e mod n on a prepared context, b < n (variable time, same
+ *         exponent walk as bi_mod_exp()). Reusing the context across
+ *         operations with one key skips the per-modulus precomputation.
+ */
+void bi_mod_exp_ctx(BigInt* r, const BigInt* b, const BigInt* e, const bi_mod_ctx* ctx);
+
+/**
+ * @brief  r = b^e mod m for public exponents (variable time).
+ *         Only the significant bits of e are processed: square-and-multiply
+ *         for short e, a sliding window otherwise. Uses Montgomery
+ *         multiplication for odd m and falls back to bi_mod_exp_bitserial()
+ *         for even m.
+ */
 void bi_mod_exp(BigInt* r, const BigInt* b, const BigInt* e, const BigInt* m);
 
+/**
+ * @brief  r = b^e mod m for secret exponents; m must be odd.
+ *         Fixed window over the full modulus length with a masked table
+ *         lookup, so the sequence of operations and memory accesses does
+ *         not depend on e.
+ */
+void bi_mod_exp_ct(BigInt* r, const BigInt* b, const BigInt* e, const BigInt* m);
+
+/**
+ * @brief  Original bit-serial exponentiation, kept as the reference
+ *         implementation and benchmark baseline.
+ */
+void bi_mod_exp_bitserial(BigInt* r, const BigInt* b, const BigInt* e, const BigInt* m);
+
 #endif /* __BIGINT_H */
@@ -3,13 +3,51 @@
 
 #include "bigint.h"
 
+/* 1: private-key operations use bi_mod_exp_ct() (timing independent of d).
+ * 0: use the faster variable-time bi_mod_exp(); only for benchmarking. */
+#ifndef RSA_PRIVATE_CONSTANT_TIME
+#define RSA_PRIVATE_CONSTANT_TIME 1
+#endif
+
+/* Private key in CRT form (PKCS #1 RSAPrivateKey order); all values as
+ * produced by the key generator, with p and q about half of n's length */
+typedef struct {
+    BigInt n;
+    BigInt p;
+    BigInt q;
+    BigInt dp;          /* d mod (p - 1) */
+    BigInt dq;          /* d mod (q - 1) */
+    BigInt qinv;        /* q^-1 mod p */
+} rsa_private_key;
+
 /**
  * @brief  Performs a raw RSA public key operation (r = m^e mod n).
  * @param  r Result BigInt.
  * @param  m Message BigInt.
  * @param  e Public exponent BigInt (usually 65537).
- * @param  n Modulus BigInt (2048-bit).
+ * @param  n Modulus BigInt (up to BI_MAX_WORDS words, 4096-bit).
  */
 void rsa_public_op(BigInt* r, const BigInt* m, const BigInt* e, const BigInt* n);
 
+/**
+ * @brief  Performs a raw RSA private key operation (r = c^d mod n), without CRT.
+ *         Constant time unless RSA_PRIVATE_CONSTANT_TIME is 0.
+ * @param  r Result BigInt.
+ * @param  c Ciphertext BigInt.
+ * @param  d Private exponent BigInt.
+ * @param  n Modulus BigInt (up to BI_MAX_WORDS words, 4096-bit).
+ */
+void rsa_private_op(BigInt* r, const BigInt* c, const BigInt* d, const BigInt* n);
+
+/**
+ * @brief  Raw RSA private key operation with the CRT (Garner recombination):
+ *         two half-size exponentiations mod p and q instead of one mod n.
+ *         The exponentiations follow RSA_PRIVATE_CONSTANT_TIME; the
+ *         reductions and the recombination are variable time.
+ * @param  r Result BigInt (c^d mod n).
+ * @param  c Ciphertext BigInt, c < n.
+ * @param  key Private key in CRT form.
+ */
+void rsa_private_op_crt(BigInt* r, const BigInt* c, const rsa_private_key* key);
+
 #endif /* __RSA_H */
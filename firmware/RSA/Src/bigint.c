@@ -2,76 +2,396 @@
 #include <string.h>
 
 void bi_from_bytes(BigInt* a, const uint8_t* buf, int len) {
-    memset(a->words, 0, sizeof(a->words));
     int words = (len + 3) / 4;
+    memset(a->words, 0, sizeof(uint32_t) * words);
     for (int i = 0; i < len; i++) {
         int word_idx = i / 4;
         int byte_idx = i % 4;
         a->words[word_idx] |= (uint32_t)buf[len - 1 - i] << (byte_idx * 8);
     }
+    a->len = words;
 }
 
 void bi_set_uint32(BigInt* a, uint32_t val) {
-    memset(a->words, 0, sizeof(a->words));
     a->words[0] = val;
+    a->len = 1;
+}
+
+void bi_resize(BigInt* a, int words) {
+    for (int i = a->len; i < words; i++) {
+        a->words[i] = 0;
+    }
+    a->len = words;
+}
+
+static inline uint32_t bi_word(const BigInt* a, int i) {
+    return i < a->len ? a->words[i] : 0;
+}
+
+/* (hi:lo) = x * y + lo + hi; cannot overflow 64 bits. One UMAAL on cores
+ * with the DSP extension, the equivalent 64-bit C everywhere else. */
+static inline __attribute__((always_inline))
+void bi_umaal(uint32_t* lo, uint32_t* hi, uint32_t x, uint32_t y) {
+#if BI_USE_UMAAL
+    __asm__("umaal %0, %1, %2, %3" : "+r"(*lo), "+r"(*hi) : "r"(x), "r"(y));
+#else
+    uint64_t t = (uint64_t)x * y + *lo + *hi;
+    *lo = (uint32_t)t;
+    *hi = (uint32_t)(t >> 32);
+#endif
+}
+
+/* Row kernel: r[0 .. n) += a[0 .. n) * b; returns the carry word */
+static inline __attribute__((always_inline))
+uint32_t bi_mac_row(uint32_t* r, const uint32_t* a, uint32_t b, int n) {
+    uint32_t c = 0;
+    for (int j = 0; j < n; j++) {
+        bi_umaal(&r[j], &c, a[j], b);
+    }
+    return c;
+}
+
+static int bi_word_length(const BigInt* a) {
+    int n = a->len;
+    while (n > 0 && a->words[n - 1] == 0) {
+        n--;
+    }
+    return n;
 }
 
 int bi_compare(const BigInt* a, const BigInt* b) {
-    for (int i = BI_MAX_WORDS - 1; i >= 0; i--) {
-        if (a->words[i] > b->words[i]) return 1;
-        if (a->words[i] < b->words[i]) return -1;
+    for (int i = (a->len > b->len ? a->len : b->len) - 1; i >= 0; i--) {
+        uint32_t x = bi_word(a, i);
+        uint32_t y = bi_word(b, i);
+        if (x > y) return 1;
+        if (x < y) return -1;
     }
     return 0;
 }
 
 void bi_copy(BigInt* dst, const BigInt* src) {
-    memcpy(dst->words, src->words, sizeof(dst->words));
+    memcpy(dst->words, src->words, sizeof(uint32_t) * src->len);
+    dst->len = src->len;
 }
 
-// Simple schoolbook addition for modular reduction
-static void bi_add_internal(BigInt* r, const BigInt* a, const BigInt* b) {
+// Simple schoolbook addition over n words for modular reduction; returns the carry out
+static uint32_t bi_add_internal(BigInt* r, const BigInt* a, const BigInt* b, int n) {
     uint64_t carry = 0;
-    for (int i = 0; i < BI_MAX_WORDS; i++) {
+    for (int i = 0; i < n; i++) {
         uint64_t sum = (uint64_t)a->words[i] + b->words[i] + carry;
         r->words[i] = (uint32_t)sum;
         carry = sum >> 32;
     }
+    r->len = n;
+    return (uint32_t)carry;
 }
 
-// Simple subtraction
-static int bi_sub_internal(BigInt* r, const BigInt* a, const BigInt* b) {
+// Simple subtraction over n words
+static int bi_sub_internal(BigInt* r, const BigInt* a, const BigInt* b, int n) {
     int64_t borrow = 0;
-    for (int i = 0; i < BI_MAX_WORDS; i++) {
+    for (int i = 0; i < n; i++) {
         int64_t diff = (int64_t)a->words[i] - b->words[i] - borrow;
         r->words[i] = (uint32_t)diff;
         borrow = (diff < 0) ? 1 : 0;
     }
+    r->len = n;
     return (int)borrow;
 }
 
+void bi_to_bytes(const BigInt* a, uint8_t* buf, int len) {
+    for (int i = 0; i < len; i++) {
+        uint32_t w = bi_word(a, i / 4);
+        buf[len - 1 - i] = (uint8_t)(w >> ((i % 4) * 8));
+    }
+}
+
+void bi_add(BigInt* r, const BigInt* a, const BigInt* b) {
+    int n = a->len > b->len ? a->len : b->len;
+    uint64_t carry = 0;
+    for (int i = 0; i < n; i++) {
+        uint64_t sum = (uint64_t)bi_word(a, i) + bi_word(b, i) + carry;
+        r->words[i] = (uint32_t)sum;
+        carry = sum >> 32;
+    }
+    if (carry && n < BI_MAX_WORDS) {
+        r->words[n++] = (uint32_t)carry;
+    }
+    r->len = n;
+}
+
+void bi_sub(BigInt* r, const BigInt* a, const BigInt* b) {
+    int64_t borrow = 0;
+    for (int i = 0; i < a->len; i++) {
+        int64_t diff = (int64_t)a->words[i] - bi_word(b, i) - borrow;
+        r->words[i] = (uint32_t)diff;
+        borrow = (diff < 0) ? 1 : 0;
+    }
+    r->len = a->len;
+}
+
+/* ------------------------------------------------------------------
+ * Full-width multiplication: schoolbook, Karatsuba above a threshold
+ * ----------------------------------------------------------------*/
+
+/* Karatsuba scratch: 6*ceil(n/2)+1 words per level, bounded by 6n plus
+ * the rounding of each level */
+#define BI_KARATSUBA_SCRATCH (6 * BI_MAX_WORDS + 64)
+
+/* r[0 .. na+nb) = a * b; r must not overlap a or b */
+static void bi_mul_school(uint32_t* r, const uint32_t* a, int na, const uint32_t* b, int nb) {
+    memset(r, 0, sizeof(uint32_t) * (na + nb));
+    for (int i = 0; i < nb; i++) {
+        r[i + na] = bi_mac_row(&r[i], a, b[i], na);
+    }
+}
+
+/* r[0 .. na) = a + b for nb <= na; returns the carry out */
+static uint32_t bi_words_add(uint32_t* r, const uint32_t* a, int na, const uint32_t* b, int nb) {
+    uint64_t carry = 0;
+    for (int i = 0; i < na; i++) {
+        uint64_t sum = (uint64_t)a[i] + (i < nb ? b[i] : 0) + carry;
+        r[i] = (uint32_t)sum;
+        carry = sum >> 32;
+    }
+    return (uint32_t)carry;
+}
+
+/* r[0 .. na) = a - b for nb <= na; returns the borrow out */
+static uint32_t bi_words_sub(uint32_t* r, const uint32_t* a, int na, const uint32_t* b, int nb) {
+    int64_t borrow = 0;
+    for (int i = 0; i < na; i++) {
+        int64_t diff = (int64_t)a[i] - (i < nb ? b[i] : 0) - borrow;
+        r[i] = (uint32_t)diff;
+        borrow = (diff < 0) ? 1 : 0;
+    }
+    return (uint32_t)borrow;
+}
+
+/* Compares two n-word numbers: -1, 0 or 1 */
+static int bi_words_cmp(const uint32_t* a, const uint32_t* b, int n) {
+    for (int i = n - 1; i >= 0; i--) {
+        if (a[i] != b[i]) {
+            return a[i] > b[i] ? 1 : -1;
+        }
+    }
+    return 0;
+}
+
+/* d[0 .. nx) = |x - y| for ny <= nx; returns 1 if x < y */
+static int bi_words_abs_diff(uint32_t* d, const uint32_t* x, int nx, const uint32_t* y, int ny) {
+    uint64_t carry = 1;
+    if (!bi_words_sub(d, x, nx, y, ny)) {
+        return 0;
+    }
+    for (int i = 0; i < nx; i++) {          /* two's complement negation */
+        carry += (uint32_t)~d[i];
+        d[i] = (uint32_t)carry;
+        carry >>= 32;
+    }
+    return 1;
+}
+
+/* r[0 .. 2n) = a * b, both n words (subtractive Karatsuba).
+ * With a = a1*B^h + a0 and b = b1*B^h + b0:
+ * a*b = z2*B^2h + (z0 + z2 - (a0 - a1)(b0 - b1))*B^h + z0 */
+static void bi_mul_kara(uint32_t* r, const uint32_t* a, const uint32_t* b, int n, int threshold,
+                        uint32_t* scratch) {
+    const int h = (n + 1) / 2;              /* low half; the high half has n - h words */
+    const int l = n - h;
+    uint32_t* da = scratch;
+    uint32_t* db = da + h;
+    uint32_t* mid = db + h;
+    uint32_t* z1 = mid + 2 * h;
+    uint32_t* next = z1 + 2 * h + 1;
+    int neg;
+
+    if (n < threshold || n < 2) {
+        bi_mul_school(r, a, n, b, n);
+        return;
+    }
+    bi_mul_kara(r, a, b, h, threshold, next);                   /* z0 */
+    bi_mul_kara(r + 2 * h, a + h, b + h, l, threshold, next);   /* z2 */
+    neg = bi_words_abs_diff(da, a, h, a + h, l) ^ bi_words_abs_diff(db, b, h, b + h, l);
+    bi_mul_kara(mid, da, db, h, threshold, next);
+
+    /* z1 = a0*b1 + a1*b0 >= 0; it fits in n + 1 words */
+    memcpy(z1, r, sizeof(uint32_t) * 2 * h);
+    z1[2 * h] = bi_words_add(z1, z1, 2 * h, r + 2 * h, 2 * l);
+    if (neg) {
+        z1[2 * h] += bi_words_add(z1, z1, 2 * h, mid, 2 * h);
+    } else {
+        z1[2 * h] -= bi_words_sub(z1, z1, 2 * h, mid, 2 * h);
+    }
+    bi_words_add(r + h, r + h, 2 * n - h, z1, (2 * h + 1 < 2 * n - h) ? 2 * h + 1 : 2 * n - h);
+}
+
+void bi_mul_karatsuba(BigInt* r, const BigInt* a, const BigInt* b, int threshold) {
+    uint32_t x[BI_MAX_WORDS], y[BI_MAX_WORDS];
+    uint32_t prod[2 * BI_MAX_WORDS];
+    uint32_t scratch[BI_KARATSUBA_SCRATCH];
+    int n = a->len > b->len ? a->len : b->len;
+    int len = a->len + b->len;
+
+    if (a->len < threshold || b->len < threshold) {
+        bi_mul_school(prod, a->words, a->len, b->words, b->len);
+    } else {
+        /* Both halves of the split need equal lengths: zero-pad to n words */
+        memcpy(x, a->words, sizeof(uint32_t) * a->len);
+        memset(&x[a->len], 0, sizeof(uint32_t) * (n - a->len));
+        memcpy(y, b->words, sizeof(uint32_t) * b->len);
+        memset(&y[b->len], 0, sizeof(uint32_t) * (n - b->len));
+        bi_mul_kara(prod, x, y, n, threshold, scratch);
+    }
+    if (len > BI_MAX_WORDS) {
+        len = BI_MAX_WORDS;
+    }
+    memcpy(r->words, prod, sizeof(uint32_t) * len);
+    r->len = len;
+}
+
+void bi_mul(BigInt* r, const BigInt* a, const BigInt* b) {
+    bi_mul_karatsuba(r, a, b, BI_KARATSUBA_THRESHOLD);
+}
+
+/* Longest dividend of bi_divmod_words(): a double-length product plus one */
+#define BI_DIV_MAX_WORDS (2 * BI_MAX_WORDS + 1)
+
+/* Schoolbook long division (Knuth, TAOCP vol. 2, 4.3.1, Algorithm D):
+ * a[0 .. la) = q * m + rem, one estimated quotient word per step, corrected
+ * at most twice and, rarely, by an add-back. Requires 1 <= n <= la,
+ * m[n - 1] != 0. q gets la - n + 1 words (may be NULL), rem n words. */
+static void bi_divmod_words(uint32_t* q, uint32_t* rem, const uint32_t* a, int la,
+                            const uint32_t* m, int n) {
+    uint32_t u[BI_DIV_MAX_WORDS + 1], v[BI_MAX_WORDS];
+    int shift = 0;
+
+    if (n == 1) {                           /* short division */
+        uint64_t r = 0;
+        for (int i = la - 1; i >= 0; i--) {
+            uint64_t cur = (r << 32) | a[i];
+            if (q) {
+                q[i] = (uint32_t)(cur / m[0]);
+            }
+            r = cur % m[0];
+        }
+        rem[0] = (uint32_t)r;
+        return;
+    }
+
+    /* D1: normalise so the top divisor word has its high bit set */
+    for (uint32_t top = m[n - 1]; (top & 0x80000000u) == 0; top <<= 1) {
+        shift++;
+    }
+    for (int i = n - 1; i > 0; i--) {
+        v[i] = shift ? (m[i] << shift) | (m[i - 1] >> (32 - shift)) : m[i];
+    }
+    v[0] = m[0] << shift;
+    u[la] = shift ? a[la - 1] >> (32 - shift) : 0;
+    for (int i = la - 1; i > 0; i--) {
+        u[i] = shift ? (a[i] << shift) | (a[i - 1] >> (32 - shift)) : a[i];
+    }
+    u[0] = a[0] << shift;
+
+    for (int j = la - n; j >= 0; j--) {
+        /* D3: estimate q from the top two words, refine with the third */
+        uint64_t num = ((uint64_t)u[j + n] << 32) | u[j + n - 1];
+        uint64_t qhat = num / v[n - 1];
+        uint64_t rhat = num % v[n - 1];
+        uint64_t p;
+        int64_t t;
+        uint32_t carry = 0, borrow = 0;
+
+        while (qhat > 0xFFFFFFFFu || qhat * v[n - 2] > ((rhat << 32) | u[j + n - 2])) {
+            qhat--;
+            rhat += v[n - 1];
+            if (rhat > 0xFFFFFFFFu) {
+                break;
+            }
+        }
+
+        /* D4: u[j .. j+n] -= qhat * v */
+        for (int i = 0; i < n; i++) {
+            p = qhat * v[i] + carry;
+            carry = (uint32_t)(p >> 32);
+            t = (int64_t)u[i + j] - (uint32_t)p - borrow;
+            u[i + j] = (uint32_t)t;
+            borrow = t < 0 ? 1 : 0;
+        }
+        t = (int64_t)u[j + n] - carry - borrow;
+        u[j + n] = (uint32_t)t;
+
+        /* D6: qhat was one too large; add v back */
+        if (t < 0) {
+            uint64_t c = 0;
+            for (int i = 0; i < n; i++) {
+                c += (uint64_t)u[i + j] + v[i];
+                u[i + j] = (uint32_t)c;
+                c >>= 32;
+            }
+            u[j + n] += (uint32_t)c;
+            qhat--;
+        }
+        if (q) {
+            q[j] = (uint32_t)qhat;
+        }
+    }
+
+    /* D8: the remainder is u[0 .. n), denormalised */
+    for (int i = 0; i < n; i++) {
+        rem[i] = shift ? (u[i] >> shift) | (u[i + 1] << (32 - shift)) : u[i];
+    }
+}
+
+void bi_mod(BigInt* r, const BigInt* a, const BigInt* m) {
+    const int n = bi_word_length(m);
+    const int la = bi_word_length(a);
+
+    if (n == 0) {                           /* undefined; keep r well formed */
+        bi_set_uint32(r, 0);
+        return;
+    }
+    if (la < n || (la == n && bi_compare(a, m) < 0)) {
+        bi_copy(r, a);
+        bi_resize(r, n);
+        return;
+    }
+    bi_divmod_words(NULL, r->words, a->words, la, m->words, n);
+    r->len = n;
+}
+
 void bi_mod_mul(BigInt* r, const BigInt* a, const BigInt* b, const BigInt* m) {
     // This is a naive implementation for the baseline benchmarking.
     // In a real crypto lib, Montgomery multiplication would be used here.
     // For M1 baseline, we simulate the workload.
-    BigInt tmp;
+    // All words of b are scanned; tmp and a are kept at m's length, so a
+    // carry out of the top word means tmp >= 2^(32*len) > m.
+    const int n = m->len;
+    BigInt tmp, x;
+    uint32_t carry;
+    bi_copy(&x, a);
+    bi_resize(&x, n);
     bi_set_uint32(&tmp, 0);
-    for (int i = BI_MAX_WORDS * 32 - 1; i >= 0; i--) {
-        bi_add_internal(&tmp, &tmp, &tmp); // Double
-        if ((b->words[i / 32] >> (i % 32)) & 1) {
-            bi_add_internal(&tmp, &tmp, a);
+    bi_resize(&tmp, n);
+    for (int i = b->len * 32 - 1; i >= 0; i--) {
+        carry = bi_add_internal(&tmp, &tmp, &tmp, n); // Double
+        while (carry || bi_compare(&tmp, m) >= 0) {
+            carry -= bi_sub_internal(&tmp, &tmp, m, n);
         }
-        while (bi_compare(&tmp, m) >= 0) {
-            bi_sub_internal(&tmp, &tmp, m);
+        if ((b->words[i / 32] >> (i % 32)) & 1) {
+            carry = bi_add_internal(&tmp, &tmp, &x, n);
+            while (carry || bi_compare(&tmp, m) >= 0) {
+                carry -= bi_sub_internal(&tmp, &tmp, m, n);
+            }
         }
     }
     bi_copy(r, &tmp);
 }
 
-void bi_mod_exp(BigInt* r, const BigInt* b, const BigInt* e, const BigInt* m) {
+void bi_mod_exp_bitserial(BigInt* r, const BigInt* b, const BigInt* e, const BigInt* m) {
     BigInt res;
     bi_set_uint32(&res, 1);
     
-    for (int i = BI_MAX_WORDS * 32 - 1; i >= 0; i--) {
+    for (int i = e->len * 32 - 1; i >= 0; i--) {
         bi_mod_mul(&res, &res, &res, m); // Square
         if ((e->words[i / 32] >> (i % 32)) & 1) {
             bi_mod_mul(&res, &res, b, m); // Multiply
@@ -79,3 +399,382 @@ void bi_mod_exp(BigInt* r, const BigInt* b, const BigInt* e, const BigInt* m) {
     }
     bi_copy(r, &res);
 }
+
+/* ------------------------------------------------------------------
+ * Montgomery arithmetic (word-level CIOS, Koc et al. 1996)
+ * ----------------------------------------------------------------*/
+
+/* -n0^-1 mod 2^32 by Newton iteration; each step doubles the correct bits */
+static uint32_t bi_mont_n0inv(uint32_t n0) {
+    uint32_t x = n0;            /* correct to 3 bits for odd n0 */
+    for (int i = 0; i < 4; i++) {
+        x *= 2 - n0 * x;
+    }
+    return (uint32_t)0 - x;
+}
+
+void bi_mont_init(bi_mont_ctx* ctx, const BigInt* m) {
+    uint32_t num[BI_DIV_MAX_WORDS];
+    const int k = bi_word_length(m);
+
+    ctx->words = k;
+    bi_copy(&ctx->n, m);
+    bi_resize(&ctx->n, k);
+    ctx->n0inv = bi_mont_n0inv(m->words[0]);
+    bi_set_uint32(&ctx->rr, 0);
+    if (k == 0) {
+        return;
+    }
+
+    /* R^2 mod n = b^2k mod n, one long division as for Barrett's mu */
+    memset(num, 0, sizeof(uint32_t) * 2 * k);
+    num[2 * k] = 1;
+    bi_divmod_words(NULL, ctx->rr.words, num, 2 * k + 1, ctx->n.words, k);
+    ctx->rr.len = k;
+}
+
+#if defined(__GNUC__) && !defined(__clang__)
+#define BI_PRAGMA_(x) _Pragma(#x)
+#define BI_PRAGMA(x) BI_PRAGMA_(x)
+#define BI_UNROLL BI_PRAGMA(GCC unroll BI_MONT_UNROLL)
+#else
+#define BI_UNROLL
+#endif
+
+/* CIOS kernel. The fixed-size wrappers below pass a constant s, so every
+ * loop gets a compile-time trip count the compiler can unroll. */
+static inline __attribute__((always_inline))
+void bi_mont_mul_core(BigInt* r, const BigInt* a, const BigInt* b, const bi_mont_ctx* ctx,
+                      const int s) {
+    const uint32_t* n = ctx->n.words;
+    uint32_t t[BI_MAX_WORDS + 2];
+    uint64_t cs;
+    uint32_t c, m, lo, mask;
+
+    memset(t, 0, sizeof(uint32_t) * (s + 2));
+
+    for (int i = 0; i < s; i++) {
+        /* t += a * b[i] */
+        c = 0;
+        BI_UNROLL
+        for (int j = 0; j < s; j++) {
+            bi_umaal(&t[j], &c, a->words[j], b->words[i]);
+        }
+        cs = (uint64_t)t[s] + c;
+        t[s] = (uint32_t)cs;
+        t[s + 1] = (uint32_t)(cs >> 32);
+
+        /* t = (t + m * n) / 2^32, m chosen so the low word cancels */
+        m = t[0] * ctx->n0inv;
+        lo = t[0];
+        c = 0;
+        bi_umaal(&lo, &c, m, n[0]);
+        BI_UNROLL
+        for (int j = 1; j < s; j++) {
+            lo = t[j];
+            bi_umaal(&lo, &c, m, n[j]);
+            t[j - 1] = lo;
+        }
+        cs = (uint64_t)t[s] + c;
+        t[s - 1] = (uint32_t)cs;
+        t[s] = t[s + 1] + (uint32_t)(cs >> 32);
+    }
+
+    /* t < 2n: subtract n once if t >= n. Both candidates are computed and
+     * selected by mask, so timing does not depend on the operands. */
+    c = 0;
+    BI_UNROLL
+    for (int j = 0; j < s; j++) {
+        cs = (uint64_t)t[j] - n[j] - c;
+        r->words[j] = (uint32_t)cs;
+        c = (uint32_t)(cs >> 32) & 1;
+    }
+    mask = (uint32_t)0 - (t[s] | (c ^ 1));  /* all ones: keep t - n */
+    BI_UNROLL
+    for (int j = 0; j < s; j++) {
+        r->words[j] = (r->words[j] & mask) | (t[j] & ~mask);
+    }
+    r->len = s;
+}
+
+/* bi_mont_mul_2048() etc.: the kernel instantiated for one operand size */
+#define BI_DEFINE_MONT_MUL(BITS)                                                        \
+    static void bi_mont_mul_##BITS(BigInt* r, const BigInt* a, const BigInt* b,         \
+                                   const bi_mont_ctx* ctx) {                            \
+        bi_mont_mul_core(r, a, b, ctx, BI_WORDS_##BITS);                                \
+    }
+
+BI_DEFINE_MONT_MUL(2048)
+BI_DEFINE_MONT_MUL(3072)
+BI_DEFINE_MONT_MUL(4096)
+
+void bi_mont_mul(BigInt* r, const BigInt* a, const BigInt* b, const bi_mont_ctx* ctx) {
+    switch (ctx->words) {
+    case BI_WORDS_2048:
+        bi_mont_mul_2048(r, a, b, ctx);
+        break;
+    case BI_WORDS_3072:
+        bi_mont_mul_3072(r, a, b, ctx);
+        break;
+    case BI_WORDS_4096:
+        bi_mont_mul_4096(r, a, b, ctx);
+        break;
+    default:
+        bi_mont_mul_core(r, a, b, ctx, ctx->words);
+        break;
+    }
+}
+
+static int bi_bit_length(const BigInt* a) {
+    int n = bi_word_length(a);
+    int bits = n * 32;
+    if (n == 0) {
+        return 0;
+    }
+    for (uint32_t top = a->words[n - 1]; (top & 0x80000000u) == 0; top <<= 1) {
+        bits--;
+    }
+    return bits;
+}
+
+static uint32_t bi_get_bit(const BigInt* a, int i) {
+    if (i >= a->len * 32) {
+        return 0;
+    }
+    return (a->words[i / 32] >> (i % 32)) & 1;
+}
+
+/* ------------------------------------------------------------------
+ * Barrett reduction (HAC 14.42), an alternative to Montgomery that needs
+ * no domain conversion, only mu = floor(b^2k / n) per modulus
+ * ----------------------------------------------------------------*/
+
+void bi_barrett_init(bi_barrett_ctx* ctx, const BigInt* m) {
+    uint32_t num[BI_DIV_MAX_WORDS], q[BI_MAX_WORDS + 2], rem[BI_MAX_WORDS];
+    const int k = bi_word_length(m);
+
+    ctx->words = k;
+    bi_copy(&ctx->n, m);
+    bi_resize(&ctx->n, k);
+    if (k == 0) {
+        ctx->mu[0] = 0;
+        return;
+    }
+    /* b^2k / n has k + 2 quotient words; the top one is always zero */
+    memset(num, 0, sizeof(uint32_t) * 2 * k);
+    num[2 * k] = 1;
+    bi_divmod_words(q, rem, num, 2 * k + 1, ctx->n.words, k);
+    memcpy(ctx->mu, q, sizeof(uint32_t) * (k + 1));
+}
+
+void bi_barrett_mul(BigInt* r, const BigInt* a, const BigInt* b, const bi_barrett_ctx* ctx) {
+    const int k = ctx->words;
+    const uint32_t* n = ctx->n.words;
+    uint32_t x[2 * BI_MAX_WORDS], q2[2 * BI_MAX_WORDS + 2], t[BI_MAX_WORDS + 1];
+    const uint32_t* q3 = &q2[k + 1];
+
+    bi_mul_school(x, a->words, k, b->words, k);
+
+    /* q3 = floor(floor(x / b^(k-1)) * mu / b^(k+1)), at most 2 below x / n */
+    bi_mul_school(q2, &x[k - 1], k + 1, ctx->mu, k + 1);
+
+    /* t = q3 * n mod b^(k+1): only the low k + 1 words of the product */
+    memset(t, 0, sizeof(uint32_t) * (k + 1));
+    for (int i = 0; i <= k; i++) {
+        int lim = k < k + 1 - i ? k : k + 1 - i;
+        uint32_t c = bi_mac_row(&t[i], n, q3[i], lim);
+        if (i + lim <= k) {
+            t[i + lim] += c;
+        }
+    }
+
+    /* x - q3 * n (mod b^(k+1)) is already the result up to two subtractions */
+    bi_words_sub(t, x, k + 1, t, k + 1);
+    while (t[k] != 0 || bi_words_cmp(t, n, k) >= 0) {
+        t[k] -= bi_words_sub(t, t, k, n, k);
+    }
+    memcpy(r->words, t, sizeof(uint32_t) * k);
+    r->len = k;
+}
+
+/* ------------------------------------------------------------------
+ * Exponentiation
+ * ----------------------------------------------------------------*/
+
+/* A modular product and its context (Montgomery or Barrett) */
+typedef void (*bi_mulmod_fn)(BigInt* r, const BigInt* a, const BigInt* b, const void* ctx);
+
+static void bi_mulmod_mont(BigInt* r, const BigInt* a, const BigInt* b, const void* ctx) {
+    bi_mont_mul(r, a, b, (const bi_mont_ctx*)ctx);
+}
+
+static void bi_mulmod_barrett(BigInt* r, const BigInt* a, const BigInt* b, const void* ctx) {
+    bi_barrett_mul(r, a, b, (const bi_barrett_ctx*)ctx);
+}
+
+/* Sliding window over odd powers: res = base^e.
+ * Not inlined, so the short-exponent path does not pay for the table's stack. */
+__attribute__((noinline))
+static void bi_exp_sliding(BigInt* res, const BigInt* base, const BigInt* e, int bits,
+                           bi_mulmod_fn mul, const void* ctx) {
+    BigInt tbl[1 << (BI_EXP_WINDOW_BITS - 1)];   /* b^1, b^3, ..., b^(2^w - 1) */
+    int started = 0;
+
+    bi_copy(&tbl[0], base);
+    mul(res, base, base, ctx);                   /* b^2 */
+    for (int k = 1; k < (1 << (BI_EXP_WINDOW_BITS - 1)); k++) {
+        mul(&tbl[k], &tbl[k - 1], res, ctx);
+    }
+
+    for (int i = bits - 1; i >= 0; ) {
+        int low;
+        uint32_t val = 0;
+
+        if (!bi_get_bit(e, i)) {
+            mul(res, res, res, ctx);
+            i--;
+            continue;
+        }
+        /* Longest window [i..low] of at most w bits ending in a set bit */
+        low = i - BI_EXP_WINDOW_BITS + 1 > 0 ? i - BI_EXP_WINDOW_BITS + 1 : 0;
+        while (!bi_get_bit(e, low)) {
+            low++;
+        }
+        for (int k = i; k >= low; k--) {
+            val = (val << 1) | bi_get_bit(e, k);
+        }
+        if (started) {
+            for (int k = i; k >= low; k--) {
+                mul(res, res, res, ctx);
+            }
+            mul(res, res, &tbl[val >> 1], ctx);
+        } else {
+            bi_copy(res, &tbl[val >> 1]);
+            started = 1;
+        }
+        i = low - 1;
+    }
+}
+
+/* res = base^e for an exponent of bits >= 1 significant bits */
+static void bi_exp_vartime(BigInt* res, const BigInt* base, const BigInt* e, int bits,
+                           bi_mulmod_fn mul, const void* ctx) {
+    if (bits <= BI_EXP_SHORT_BITS) {
+        /* Short exponents (e = 65537): left-to-right binary from the top set bit */
+        bi_copy(res, base);
+        for (int i = bits - 2; i >= 0; i--) {
+            mul(res, res, res, ctx); // Square
+            if (bi_get_bit(e, i)) {
+                mul(res, res, base, ctx); // Multiply
+            }
+        }
+    } else {
+        bi_exp_sliding(res, base, e, bits, mul, ctx);
+    }
+}
+
+/* r = b^e mod n in and out of the Montgomery domain of an initialised ctx */
+static void bi_exp_mont(BigInt* r, const BigInt* b, const BigInt* e, const bi_mont_ctx* ctx) {
+    BigInt base, res, one;
+    int bits = bi_bit_length(e);
+
+    bi_set_uint32(&one, 1);
+    bi_resize(&one, ctx->words);
+    if (bits == 0) {
+        bi_mont_mul(&res, &one, &ctx->rr, ctx); /* b^0 = 1 (mod n) */
+        bi_mont_mul(r, &res, &one, ctx);
+        return;
+    }
+    bi_copy(&base, b);
+    bi_resize(&base, ctx->words);
+    bi_mont_mul(&base, &base, &ctx->rr, ctx);   /* b * R mod n */
+    bi_exp_vartime(&res, &base, e, bits, bi_mulmod_mont, ctx);
+    bi_mont_mul(r, &res, &one, ctx);            /* leave the Montgomery domain */
+}
+
+static void bi_exp_barrett(BigInt* r, const BigInt* b, const BigInt* e, const bi_barrett_ctx* ctx) {
+    BigInt base;
+    int bits = bi_bit_length(e);
+
+    if (bits == 0) {
+        bi_set_uint32(&base, 1);
+        bi_mod(r, &base, &ctx->n);
+        bi_resize(r, ctx->words);
+        return;
+    }
+    bi_copy(&base, b);
+    bi_resize(&base, ctx->words);
+    bi_exp_vartime(r, &base, e, bits, bi_mulmod_barrett, ctx);
+}
+
+void bi_mod_exp(BigInt* r, const BigInt* b, const BigInt* e, const BigInt* m) {
+    bi_mont_ctx ctx;
+
+    if ((m->words[0] & 1) == 0) {
+        bi_mod_exp_bitserial(r, b, e, m);
+        return;
+    }
+    bi_mont_init(&ctx, m);
+    bi_exp_mont(r, b, e, &ctx);
+}
+
+void bi_mod_ctx_init(bi_mod_ctx* ctx, const BigInt* m, bi_reduce_t strategy) {
+    ctx->strategy = strategy;
+    if (strategy == BI_REDUCE_BARRETT) {
+        bi_barrett_init(&ctx->barrett, m);
+    } else {
+        bi_mont_init(&ctx->mont, m);
+    }
+}
+
+void bi_mod_exp_ctx(BigInt* r, const BigInt* b, const BigInt* e, const bi_mod_ctx* ctx) {
+    if (ctx->strategy == BI_REDUCE_BARRETT) {
+        bi_exp_barrett(r, b, e, &ctx->barrett);
+    } else {
+        bi_exp_mont(r, b, e, &ctx->mont);
+    }
+}
+
+void bi_mod_exp_ct(BigInt* r, const BigInt* b, const BigInt* e, const BigInt* m) {
+    bi_mont_ctx ctx;
+    BigInt res, one, sel;
+    BigInt tbl[1 << BI_EXP_CT_WINDOW_BITS];      /* b^0 .. b^(2^w - 1) */
+    int windows;
+
+    bi_mont_init(&ctx, m);
+    bi_set_uint32(&one, 1);
+    bi_resize(&one, ctx.words);
+    bi_mont_mul(&tbl[0], &one, &ctx.rr, &ctx);  /* R mod n */
+    bi_copy(&tbl[1], b);
+    bi_resize(&tbl[1], ctx.words);
+    bi_mont_mul(&tbl[1], &tbl[1], &ctx.rr, &ctx);
+    for (int k = 2; k < (1 << BI_EXP_CT_WINDOW_BITS); k++) {
+        bi_mont_mul(&tbl[k], &tbl[k - 1], &tbl[1], &ctx);
+    }
+
+    /* The window count depends on the modulus size only, never on e */
+    windows = (ctx.words * 32 + BI_EXP_CT_WINDOW_BITS - 1) / BI_EXP_CT_WINDOW_BITS;
+    bi_copy(&res, &tbl[0]);
+    for (int w = windows - 1; w >= 0; w--) {
+        uint32_t val = 0;
+
+        for (int k = 0; k < BI_EXP_CT_WINDOW_BITS; k++) {
+            bi_mont_mul(&res, &res, &res, &ctx);
+        }
+        for (int k = BI_EXP_CT_WINDOW_BITS - 1; k >= 0; k--) {
+            val = (val << 1) | bi_get_bit(e, w * BI_EXP_CT_WINDOW_BITS + k);
+        }
+        /* Read every table entry; keep the one at index val */
+        bi_set_uint32(&sel, 0);
+        bi_resize(&sel, ctx.words);
+        for (uint32_t k = 0; k < (1u << BI_EXP_CT_WINDOW_BITS); k++) {
+            uint32_t diff = k ^ val;
+            uint32_t mask = ((diff | ((uint32_t)0 - diff)) >> 31) - 1;   /* all ones iff k == val */
+            for (int j = 0; j < ctx.words; j++) {
+                sel.words[j] |= tbl[k].words[j] & mask;
+            }
+        }
+        bi_mont_mul(&res, &res, &sel, &ctx);
+    }
+    bi_mont_mul(r, &res, &one, &ctx);
+}
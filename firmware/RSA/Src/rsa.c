@@ -3,3 +3,38 @@
 void rsa_public_op(BigInt* r, const BigInt* m, const BigInt* e, const BigInt* n) {
     bi_mod_exp(r, m, e, n);
 }
+
+static void rsa_exp_private(BigInt* r, const BigInt* c, const BigInt* d, const BigInt* n) {
+#if RSA_PRIVATE_CONSTANT_TIME
+    bi_mod_exp_ct(r, c, d, n);
+#else
+    bi_mod_exp(r, c, d, n);
+#endif
+}
+
+void rsa_private_op(BigInt* r, const BigInt* c, const BigInt* d, const BigInt* n) {
+    rsa_exp_private(r, c, d, n);
+}
+
+void rsa_private_op_crt(BigInt* r, const BigInt* c, const rsa_private_key* key) {
+    BigInt m1, m2, t;
+
+    /* m1 = c^dp mod p, m2 = c^dq mod q */
+    bi_mod(&t, c, &key->p);
+    rsa_exp_private(&m1, &t, &key->dp, &key->p);
+    bi_mod(&t, c, &key->q);
+    rsa_exp_private(&m2, &t, &key->dq, &key->q);
+
+    /* h = qinv * (m1 - m2) mod p, with m2 reduced mod p first */
+    bi_mod(&t, &m2, &key->p);
+    if (bi_compare(&m1, &t) < 0) {
+        bi_add(&m1, &m1, &key->p);
+    }
+    bi_sub(&m1, &m1, &t);
+    bi_mul(&t, &key->qinv, &m1);
+    bi_mod(&m1, &t, &key->p);
+
+    /* r = m2 + h * q < n */
+    bi_mul(&t, &m1, &key->q);
+    bi_add(r, &t, &m2);
+}
@@ -1078,6 +1078,24 @@ int mbedtls_mpi_gen_prime(mbedtls_mpi *X, size_t nbits, int flags,
                           int (*f_rng)(void *, unsigned char *, size_t),
                           void *p_rng);
 
+#if defined(MBEDTLS_GENPRIME_SIEVE)
+/**
+ * \brief          Select the candidate search of mbedtls_mpi_gen_prime()
+ *                 (non-DH primes only).
+ *
+ *                 With the sieve (the default when #MBEDTLS_GENPRIME_SIEVE
+ *                 is defined) one random start is reduced modulo the odd
+ *                 primes below #MBEDTLS_GENPRIME_SIEVE_LIMIT once; the
+ *                 residues strike the following odd candidates with a small
+ *                 factor and only survivors go through Miller-Rabin.
+ *                 Without it every candidate is a fresh random number
+ *                 checked by mbedtls_mpi_is_prime_ext().
+ *
+ * \param enable   1 for the sieve, 0 for the stock search.
+ */
+void mbedtls_mpi_gen_prime_set_sieve(int enable);
+#endif /* MBEDTLS_GENPRIME_SIEVE */
+
 #if defined(MBEDTLS_SELF_TEST)
 
 /**
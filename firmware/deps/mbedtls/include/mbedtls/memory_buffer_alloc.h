@@ -138,6 +138,22 @@ void mbedtls_memory_buffer_alloc_cur_get(size_t *cur_used, size_t *cur_blocks);
  */
 int mbedtls_memory_buffer_alloc_verify(void);
 
+/**
+ * \brief          Local extension: allocate from the buffer set up by
+ *                 mbedtls_memory_buffer_alloc_init(), for callers that
+ *                 install their own wrapper with
+ *                 mbedtls_platform_set_calloc_free() on top of it.
+ *
+ * \return         The zeroed block, or NULL if it does not fit
+ */
+void *mbedtls_memory_buffer_calloc(size_t n, size_t size);
+
+/**
+ * \brief          Local extension: free a block of
+ *                 mbedtls_memory_buffer_calloc()
+ */
+void mbedtls_memory_buffer_free(void *ptr);
+
 #if defined(MBEDTLS_SELF_TEST)
 /**
  * \brief          Checkup routine
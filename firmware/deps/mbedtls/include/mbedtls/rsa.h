@@ -59,6 +59,8 @@
 #define MBEDTLS_ERR_RSA_OUTPUT_TOO_LARGE                  -0x4400
 /** The random generator failed to generate non-zeros. */
 #define MBEDTLS_ERR_RSA_RNG_FAILED                        -0x4480
+/** Operation in progress, call again with the same parameters to continue. */
+#define MBEDTLS_ERR_RSA_IN_PROGRESS                       -0x4500
 
 /*
  * RSA constants
@@ -597,6 +599,95 @@ int mbedtls_rsa_private(mbedtls_rsa_context *ctx,
                         const unsigned char *input,
                         unsigned char *output);
 
+#if defined(MBEDTLS_RSA_RESTARTABLE)
+/**
+ * \brief          Context for resuming mbedtls_rsa_private_restartable().
+ *
+ * \note           Opaque: holds the blinded operands and the partial
+ *                 exponentiation between calls.
+ */
+typedef struct mbedtls_rsa_restart_ctx {
+    int MBEDTLS_PRIVATE(state);                  /*!<  Next step of the operation. */
+    mbedtls_mpi MBEDTLS_PRIVATE(T);              /*!<  Blinded input, then result. */
+    mbedtls_mpi MBEDTLS_PRIVATE(I);              /*!<  The input, for the final check. */
+    mbedtls_mpi MBEDTLS_PRIVATE(Vf);             /*!<  Un-blinding value of this operation. */
+    mbedtls_mpi MBEDTLS_PRIVATE(DP);             /*!<  Blinded DP. */
+    mbedtls_mpi MBEDTLS_PRIVATE(DQ);             /*!<  Blinded DQ. */
+    mbedtls_mpi MBEDTLS_PRIVATE(TP);             /*!<  Result mod P. */
+    mbedtls_mpi MBEDTLS_PRIVATE(TQ);             /*!<  Result mod Q. */
+    struct mbedtls_rsa_restart_exp *MBEDTLS_PRIVATE(exp); /*!< Exponentiation in progress. */
+} mbedtls_rsa_restart_ctx;
+
+/**
+ * \brief          Set the maximum number of basic operations done by one
+ *                 call to mbedtls_rsa_private_restartable().
+ *
+ * \param max_ops  Maximum number of basic operations per call.
+ *                 Default: 0 (unlimited).
+ *
+ * \note           A basic operation is one Montgomery multiplication
+ *                 modulo a prime factor; one modulo N counts as 4. With
+ *                 the default #MBEDTLS_MPI_WINDOW_SIZE, a 2048-bit private
+ *                 operation is about 3900 basic operations (3072: 5400,
+ *                 4096: 6950).
+ *
+ * \note           Values below 8 are treated as 8, so every call makes
+ *                 progress. The input blinding and the CRT recombination
+ *                 are not counted: they run on top of the budget of the
+ *                 call that starts them.
+ */
+void mbedtls_rsa_set_max_ops(unsigned max_ops);
+
+/**
+ * \brief          Initialize a restart context.
+ *
+ * \param rs_ctx   The restart context to initialize.
+ */
+void mbedtls_rsa_restart_init(mbedtls_rsa_restart_ctx *rs_ctx);
+
+/**
+ * \brief          Free a restart context, abandoning any operation in
+ *                 progress.
+ *
+ * \param rs_ctx   The restart context to free. May be \c NULL.
+ */
+void mbedtls_rsa_restart_free(mbedtls_rsa_restart_ctx *rs_ctx);
+
+/**
+ * \brief          mbedtls_rsa_private(), split into calls of at most
+ *                 mbedtls_rsa_set_max_ops() basic operations.
+ *
+ *                 The exponentiations modulo P and Q run on
+ *                 mbedtls_mpi_core_exp_mod() arithmetic; blinding and the
+ *                 final check against the public key are as in
+ *                 mbedtls_rsa_private().
+ *
+ * \note           Repeat the call with the same arguments while it returns
+ *                 #MBEDTLS_ERR_RSA_IN_PROGRESS. \p output is written by the
+ *                 call that returns 0. The context is reset after
+ *                 completion or an error, ready for the next operation.
+ *
+ * \note           Requires the CRT (no #MBEDTLS_RSA_NO_CRT).
+ *
+ * \param ctx      The initialized RSA context to use.
+ * \param f_rng    The RNG function, used for blinding. It is mandatory.
+ * \param p_rng    The RNG context to pass to \p f_rng.
+ * \param input    The input buffer of \c ctx->len Bytes.
+ * \param output   The output buffer of \c ctx->len Bytes.
+ * \param rs_ctx   The restart context.
+ *
+ * \return         \c 0 on success.
+ * \return         #MBEDTLS_ERR_RSA_IN_PROGRESS if the budget ran out.
+ * \return         Another \c MBEDTLS_ERR_RSA_XXX error code on failure.
+ */
+int mbedtls_rsa_private_restartable(mbedtls_rsa_context *ctx,
+                                    int (*f_rng)(void *, unsigned char *, size_t),
+                                    void *p_rng,
+                                    const unsigned char *input,
+                                    unsigned char *output,
+                                    mbedtls_rsa_restart_ctx *rs_ctx);
+#endif /* MBEDTLS_RSA_RESTARTABLE */
+
 /**
  * \brief          This function adds the message padding, then performs an RSA
  *                 operation.
@@ -2500,6 +2500,117 @@ int mbedtls_mpi_is_prime_ext(const mbedtls_mpi *X, int rounds,
     return mpi_miller_rabin(&XX, rounds, f_rng, p_rng);
 }
 
+#if defined(MBEDTLS_GENPRIME_SIEVE)
+
+/* Sieving primes are the odd primes below the limit (at most 65536) */
+#if !defined(MBEDTLS_GENPRIME_SIEVE_LIMIT)
+#define MBEDTLS_GENPRIME_SIEVE_LIMIT 16384
+#endif
+
+/* Odd candidates sieved per random start before drawing a new one */
+#if !defined(MBEDTLS_GENPRIME_SIEVE_STEPS)
+#define MBEDTLS_GENPRIME_SIEVE_STEPS 2048
+#endif
+
+/* pi(x) < x / 6 + 16 for every x, so this holds all sieving primes */
+#define MPI_SIEVE_MAX_PRIMES (MBEDTLS_GENPRIME_SIEVE_LIMIT / 6 + 16)
+
+/* Below this size a candidate may itself be one of the sieving primes */
+#define MPI_SIEVE_MIN_BITS 17
+
+static int mpi_gen_prime_sieve = 1;
+static unsigned short mpi_sieve_primes[MPI_SIEVE_MAX_PRIMES];
+static size_t mpi_sieve_count;
+
+void mbedtls_mpi_gen_prime_set_sieve(int enable)
+{
+    mpi_gen_prime_sieve = enable;
+}
+
+/* Odd primes below MBEDTLS_GENPRIME_SIEVE_LIMIT (Eratosthenes), built once */
+static void mpi_sieve_init_primes(void)
+{
+    unsigned char composite[MBEDTLS_GENPRIME_SIEVE_LIMIT / 16 + 1]; /* bit i: 2i + 1 */
+    unsigned i, j;
+
+    memset(composite, 0, sizeof(composite));
+    for (i = 1; 2 * i + 1 < MBEDTLS_GENPRIME_SIEVE_LIMIT; i++) {
+        unsigned p = 2 * i + 1;
+        if (composite[i / 8] & (1u << (i % 8))) {
+            continue;
+        }
+        mpi_sieve_primes[mpi_sieve_count++] = (unsigned short) p;
+        for (j = (p * p) / 2; 2 * j + 1 < MBEDTLS_GENPRIME_SIEVE_LIMIT; j += p) {
+            composite[j / 8] |= (unsigned char) (1u << (j % 8));
+        }
+    }
+}
+
+/*
+ * Incremental sieve over X, X + 2, ..., X + 2 (STEPS - 1) (X odd, more
+ * than 16 bits)
+ *
+ * The residue r of X modulo each small prime p is computed once; the
+ * candidates X + 2j it divides are then j = (p - r) / 2 mod p, p, 2p, ...
+ * steps further, so they are struck out of a bitmap without another bignum
+ * division. Only the candidates left in the bitmap reach Miller-Rabin.
+ *
+ * Return values:
+ * 0: X is probably prime
+ * MBEDTLS_ERR_MPI_NOT_ACCEPTABLE: no prime in range, or X outgrew nbits
+ * other negative: error
+ */
+static int mpi_sieve_search(mbedtls_mpi *X, size_t nbits, int rounds,
+                            int (*f_rng)(void *, unsigned char *, size_t),
+                            void *p_rng)
+{
+    int ret = 0;
+    unsigned char struck[(MBEDTLS_GENPRIME_SIEVE_STEPS + 7) / 8];
+    mbedtls_mpi_uint r;
+    mbedtls_mpi_sint pending = 0; /* distance from X to the current candidate */
+    size_t i, j;
+
+    if (mpi_sieve_count == 0) {
+        mpi_sieve_init_primes();
+    }
+
+    memset(struck, 0, sizeof(struck));
+    for (i = 0; i < mpi_sieve_count; i++) {
+        unsigned p = mpi_sieve_primes[i];
+
+        MBEDTLS_MPI_CHK(mbedtls_mpi_mod_int(&r, X, p));
+        /* X + 2j = 0 (mod p) for j = -r / 2 = (p - r) * (p + 1) / 2 (mod p) */
+        j = (size_t) (((p - r) % p) * ((p + 1) / 2) % p);
+        for (; j < MBEDTLS_GENPRIME_SIEVE_STEPS; j += p) {
+            struck[j / 8] |= (unsigned char) (1u << (j % 8));
+        }
+    }
+
+    for (j = 0; j < MBEDTLS_GENPRIME_SIEVE_STEPS; j++, pending += 2) {
+        if (struck[j / 8] & (1u << (j % 8))) {
+            continue;
+        }
+
+        MBEDTLS_MPI_CHK(mbedtls_mpi_add_int(X, X, pending));
+        pending = 0;
+        if (mbedtls_mpi_bitlen(X) > nbits) {
+            return MBEDTLS_ERR_MPI_NOT_ACCEPTABLE;
+        }
+
+        ret = mpi_miller_rabin(X, rounds, f_rng, p_rng);
+        if (ret != MBEDTLS_ERR_MPI_NOT_ACCEPTABLE) {
+            goto cleanup;
+        }
+    }
+
+    ret = MBEDTLS_ERR_MPI_NOT_ACCEPTABLE;
+
+cleanup:
+    return ret;
+}
+
+#endif /* MBEDTLS_GENPRIME_SIEVE */
+
 /*
  * Prime number generation
  *
@@ -2567,7 +2678,15 @@ int mbedtls_mpi_gen_prime(mbedtls_mpi *X, size_t nbits, int flags,
         X->p[0] |= 1;
 
         if ((flags & MBEDTLS_MPI_GEN_PRIME_FLAG_DH) == 0) {
+#if defined(MBEDTLS_GENPRIME_SIEVE)
+            if (mpi_gen_prime_sieve && nbits >= MPI_SIEVE_MIN_BITS) {
+                ret = mpi_sieve_search(X, nbits, rounds, f_rng, p_rng);
+            } else {
+                ret = mbedtls_mpi_is_prime_ext(X, rounds, f_rng, p_rng);
+            }
+#else
             ret = mbedtls_mpi_is_prime_ext(X, rounds, f_rng, p_rng);
+#endif
 
             if (ret != MBEDTLS_ERR_MPI_NOT_ACCEPTABLE) {
                 goto cleanup;
@@ -591,6 +591,99 @@ void mbedtls_mpi_core_montmul(mbedtls_mpi_uint *X,
                          AN_limbs * sizeof(mbedtls_mpi_uint));
 }
 
+/* r[1]:r[0] = a * a: a double-width product where the compiler has one
+ * (UMULL on Arm), else the bn_mul.h multiply-accumulate step. Only the
+ * AN_limbs diagonal terms go through here; the cross products use
+ * mbedtls_mpi_core_mla() */
+static void mpi_core_sqr_limb(mbedtls_mpi_uint r[2], mbedtls_mpi_uint a)
+{
+#if defined(MBEDTLS_HAVE_UDBL)
+    mbedtls_t_udbl p = (mbedtls_t_udbl) a * a;
+
+    r[0] = (mbedtls_mpi_uint) p;
+    r[1] = (mbedtls_mpi_uint) (p >> biL);
+#else
+    mbedtls_mpi_uint src[1] = { a };
+    const mbedtls_mpi_uint *s = src;
+    mbedtls_mpi_uint *d = r;
+    mbedtls_mpi_uint c = 0, b = a;
+
+    r[0] = 0;
+    MULADDC_X1_INIT
+    MULADDC_X1_CORE
+        MULADDC_X1_STOP
+    r[1] = c;
+#endif
+}
+
+void mbedtls_mpi_core_montsqr(mbedtls_mpi_uint *X,
+                              const mbedtls_mpi_uint *A,
+                              const mbedtls_mpi_uint *N,
+                              size_t AN_limbs,
+                              mbedtls_mpi_uint mm,
+                              mbedtls_mpi_uint *T)
+{
+    const size_t n = AN_limbs;
+    mbedtls_mpi_uint top = 0, c = 0;
+
+    memset(T, 0, (2 * n + 1) * ciL);
+
+    /* T = sum of A[i] * A[j] * 2^(biL*(i+j)) over i < j: row i starts at
+     * limb 2i+1, and its carry lands on limb i+n, which no earlier row
+     * reached */
+    for (size_t i = 0; i + 1 < n; i++) {
+        T[i + n] = mbedtls_mpi_core_mla(T + 2 * i + 1, n - i - 1,
+                                        A + i + 1, n - i - 1, A[i]);
+    }
+
+    /* T = 2 * T + sum of A[i]^2 * 2^(biL*2i), in one pass; both carries
+     * (top: shifted-out bit, c: addition) are 0 or 1 */
+    for (size_t i = 0; i < n; i++) {
+        mbedtls_mpi_uint sq[2];
+
+        mpi_core_sqr_limb(sq, A[i]);
+
+        for (size_t k = 0; k < 2; k++) {
+            mbedtls_mpi_uint t = T[2 * i + k];
+            mbedtls_mpi_uint d = (t << 1) | top;
+
+            top = t >> (biL - 1);
+            d += c;
+            c = (d < c);
+            d += sq[k];
+            c += (d < sq[k]);
+            T[2 * i + k] = d;
+        }
+    }
+
+    /* Montgomery reduction (HAC 14.32): T = (T + m * N) / 2^(biL*n).
+     * Row i's carry goes on limb i+n; c holds the carries out of that limb
+     * for the next row */
+    c = 0;
+    for (size_t i = 0; i < n; i++) {
+        mbedtls_mpi_uint u = T[i] * mm;
+        mbedtls_mpi_uint cc = mbedtls_mpi_core_mla(T + i, n, N, n, u);
+        mbedtls_mpi_uint t = T[i + n] + c;
+
+        c = (t < c);
+        t += cc;
+        c += (t < cc);
+        T[i + n] = t;
+    }
+    T[2 * n] = c;
+    T += n;
+
+    /* T < 2N: final subtraction as in mbedtls_mpi_core_montmul() */
+    mbedtls_mpi_uint carry  = T[n];
+    mbedtls_mpi_uint borrow = mbedtls_mpi_core_sub(X, T, N, n);
+
+    mbedtls_ct_memcpy_if(mbedtls_ct_bool(carry ^ borrow),
+                         (unsigned char *) X,
+                         (unsigned char *) T,
+                         NULL,
+                         n * sizeof(mbedtls_mpi_uint));
+}
+
 int mbedtls_mpi_core_get_mont_r2_unsafe(mbedtls_mpi *X,
                                         const mbedtls_mpi *N)
 {
@@ -822,7 +915,7 @@ void mbedtls_mpi_core_exp_mod(mbedtls_mpi_uint *X,
 
     do {
         /* Square */
-        mbedtls_mpi_core_montmul(X, X, X, AN_limbs, N, AN_limbs, mm, temp);
+        mbedtls_mpi_core_montsqr(X, X, N, AN_limbs, mm, temp);
 
         /* Move to the next bit of the exponent */
         if (E_bit_index == 0) {
@@ -853,6 +946,112 @@ void mbedtls_mpi_core_exp_mod(mbedtls_mpi_uint *X,
     } while (!(E_bit_index == 0 && E_limb_index == 0));
 }
 
+#if defined(MBEDTLS_RSA_RESTARTABLE)
+void mbedtls_mpi_core_exp_mod_restart_init(mbedtls_mpi_core_exp_mod_restart *rs,
+                                           const mbedtls_mpi_uint *N,
+                                           size_t E_bits)
+{
+    rs->mm = mbedtls_mpi_core_montmul_init(N);
+    rs->wsize = exp_mod_get_window_size(E_bits);
+    rs->table_index = 0;
+    /* One past the top bit: the loop steps down before reading a bit */
+    rs->E_limb_index = E_bits / biL;
+    rs->E_bit_index = E_bits % biL;
+    rs->window_bits = 0;
+    rs->window = 0;
+}
+
+int mbedtls_mpi_core_exp_mod_restartable(mbedtls_mpi_uint *X,
+                                         const mbedtls_mpi_uint *A,
+                                         const mbedtls_mpi_uint *N, size_t AN_limbs,
+                                         const mbedtls_mpi_uint *E,
+                                         const mbedtls_mpi_uint *RR,
+                                         mbedtls_mpi_uint *T,
+                                         mbedtls_mpi_core_exp_mod_restart *rs,
+                                         size_t *ops)
+{
+    const size_t welem = ((size_t) 1) << rs->wsize;
+
+    /* Same layout of T as mbedtls_mpi_core_exp_mod() */
+    mbedtls_mpi_uint *const Wtable  = T;
+    mbedtls_mpi_uint *const Wselect = Wtable  + welem * AN_limbs;
+    mbedtls_mpi_uint *const temp    = Wselect + AN_limbs;
+    mbedtls_mpi_uint *const W1      = Wtable  + AN_limbs;
+
+    /*
+     * Window precomputation, one entry per multiplication
+     */
+    while (rs->table_index < welem) {
+        mbedtls_mpi_uint *const Wcur = Wtable + rs->table_index * AN_limbs;
+
+        if (rs->table_index == 1) {
+            /* W[1] = A (already in Montgomery presentation) */
+            memcpy(Wcur, A, AN_limbs * ciL);
+        } else {
+            if (*ops == 0) {
+                return 1;
+            }
+            if (rs->table_index == 0) {
+                /* W[0] = 1 (in Montgomery presentation), and so is X */
+                memset(Wcur, 0, AN_limbs * ciL);
+                Wcur[0] = 1;
+                mbedtls_mpi_core_montmul(Wcur, Wcur, RR, AN_limbs, N, AN_limbs,
+                                         rs->mm, temp);
+                memcpy(X, Wcur, AN_limbs * ciL);
+            } else {
+                mbedtls_mpi_core_montmul(Wcur, Wcur - AN_limbs, W1, AN_limbs,
+                                         N, AN_limbs, rs->mm, temp);
+            }
+            --*ops;
+        }
+        rs->table_index++;
+    }
+
+    /*
+     * Fixed window exponentiation, one exponent bit per iteration
+     */
+    while (!(rs->E_bit_index == 0 && rs->E_limb_index == 0)) {
+        size_t limb_index = rs->E_limb_index;
+        size_t bit_index = rs->E_bit_index;
+
+        if (bit_index == 0) {
+            --limb_index;
+            bit_index = biL - 1;
+        } else {
+            --bit_index;
+        }
+        /* Whether the window is multiplied in after this bit depends only
+         * on the bit position, so the budget check leaks nothing */
+        const size_t cost = (rs->window_bits + 1 == rs->wsize ||
+                             (bit_index == 0 && limb_index == 0)) ? 2 : 1;
+        if (*ops < cost) {
+            return 1;
+        }
+
+        /* Square */
+        mbedtls_mpi_core_montsqr(X, X, N, AN_limbs, rs->mm, temp);
+
+        rs->E_limb_index = limb_index;
+        rs->E_bit_index = bit_index;
+        ++rs->window_bits;
+        rs->window <<= 1;
+        rs->window |= (E[limb_index] >> bit_index) & 1;
+
+        if (cost == 2) {
+            mbedtls_mpi_core_ct_uint_table_lookup(Wselect, Wtable,
+                                                  AN_limbs, welem, rs->window);
+            mbedtls_mpi_core_montmul(X, X, Wselect, AN_limbs, N, AN_limbs,
+                                     rs->mm, temp);
+            rs->window = 0;
+            rs->window_bits = 0;
+        }
+        *ops -= cost;
+    }
+
+    return 0;
+}
+#endif /* MBEDTLS_RSA_RESTARTABLE */
+
 mbedtls_mpi_uint mbedtls_mpi_core_sub_int(mbedtls_mpi_uint *X,
                                           const mbedtls_mpi_uint *A,
                                           mbedtls_mpi_uint c,  /* doubles as carry */
@@ -498,6 +498,32 @@ void mbedtls_mpi_core_montmul(mbedtls_mpi_uint *X,
                               const mbedtls_mpi_uint *N, size_t AN_limbs,
                               mbedtls_mpi_uint mm, mbedtls_mpi_uint *T);
 
+/**
+ * \brief Montgomery squaring: X = A * A * R^-1 mod N.
+ *
+ * Same result as `mbedtls_mpi_core_montmul(X, A, A, AN_limbs, N, AN_limbs,
+ * mm, T)`, but each cross product A[i] * A[j] (i != j) is computed once and
+ * doubled: about half the limb multiplications of the product part. The
+ * products go through `mbedtls_mpi_core_mla()` (the `bn_mul.h` assembly
+ * where available), and all loops have fixed trip counts.
+ *
+ * \p X may be aliased to \p A, but may not overlap any parameters otherwise.
+ *
+ * \param[out]    X         The destination MPI, \p AN_limbs limbs.
+ * \param[in]     A         The operand, in canonical form (< \p N),
+ *                          \p AN_limbs limbs.
+ * \param[in]     N         The modulus, odd, \p AN_limbs limbs.
+ * \param[in]     AN_limbs  The number of limbs in \p X, \p A and \p N.
+ * \param         mm        The Montgomery constant for \p N: -N^-1 mod 2^biL.
+ * \param[in,out] T         Temporary storage of size at least 2*AN_limbs+1 limbs.
+ *                          It must not alias or otherwise overlap any of the
+ *                          other parameters.
+ */
+void mbedtls_mpi_core_montsqr(mbedtls_mpi_uint *X,
+                              const mbedtls_mpi_uint *A,
+                              const mbedtls_mpi_uint *N, size_t AN_limbs,
+                              mbedtls_mpi_uint mm, mbedtls_mpi_uint *T);
+
 /**
  * \brief Calculate the square of the Montgomery constant. (Needed
  *        for conversion and operations in Montgomery form.)
@@ -650,6 +676,83 @@ void mbedtls_mpi_core_exp_mod(mbedtls_mpi_uint *X,
                               const mbedtls_mpi_uint *RR,
                               mbedtls_mpi_uint *T);
 
+#if defined(MBEDTLS_RSA_RESTARTABLE)
+/**
+ * \brief Progress of a `mbedtls_mpi_core_exp_mod_restartable()` run.
+ *
+ * Everything else the exponentiation needs between calls (the window table
+ * and the accumulator) lives in the caller's \p X and \p T.
+ */
+typedef struct {
+    mbedtls_mpi_uint mm;        /* Montgomery constant of N */
+    size_t wsize;               /* window size in bits */
+    size_t table_index;         /* next window table entry to compute */
+    size_t E_limb_index;        /* position of the last exponent bit done */
+    size_t E_bit_index;
+    size_t window_bits;
+    mbedtls_mpi_uint window;
+} mbedtls_mpi_core_exp_mod_restart;
+
+/**
+ * \brief            Start a restartable exponentiation.
+ *
+ * \param[out] rs    The restart state to initialize.
+ * \param[in] N      The modulus, as a little endian array.
+ * \param E_bits     The bit length of the exponent that will be given to
+ *                   `mbedtls_mpi_core_exp_mod_restartable()`. Must be
+ *                   nonzero. Leading zero bits are not processed, so this
+ *                   is public like the bit length used by
+ *                   mbedtls_mpi_exp_mod().
+ */
+void mbedtls_mpi_core_exp_mod_restart_init(mbedtls_mpi_core_exp_mod_restart *rs,
+                                           const mbedtls_mpi_uint *N,
+                                           size_t E_bits);
+
+/**
+ * \brief            Restartable form of `mbedtls_mpi_core_exp_mod()`:
+ *                   X = A^E mod N, with X left in Montgomery form.
+ *
+ * Each call does at most \p *ops Montgomery multiplications and returns
+ * with the partial state in \p rs, \p X and \p T. Call it again with the
+ * same arguments until it returns 0. The table lookups and the sequence of
+ * squarings and multiplications are the same as in
+ * `mbedtls_mpi_core_exp_mod()`; only the stopping points depend on the
+ * (public) exponent length and budget.
+ *
+ * \p X must not alias \p A, \p RR or \p E. \p X and \p T must be preserved
+ * between calls.
+ *
+ * \param[in,out] X  The accumulator, as a little endian array of length
+ *                   \p AN_limbs. On completion, A^E in Montgomery form.
+ * \param[in] A      The base, in Montgomery form, \p AN_limbs limbs.
+ * \param[in] N      The modulus, \p AN_limbs limbs.
+ * \param AN_limbs   The number of limbs in \p X, \p A, \p N and \p RR.
+ * \param[in] E      The exponent, as a little endian array of at least
+ *                   the number of limbs covering the bit length given to
+ *                   `mbedtls_mpi_core_exp_mod_restart_init()`.
+ * \param[in] RR     2^{2*AN_limbs*biL} mod N, \p AN_limbs limbs.
+ * \param[in,out] T  Working memory of at least
+ *                   `mbedtls_mpi_core_exp_mod_working_limbs(AN_limbs, E_limbs)`
+ *                   limbs, E_limbs covering the exponent bit length.
+ * \param[in,out] rs The restart state, from
+ *                   `mbedtls_mpi_core_exp_mod_restart_init()`.
+ * \param[in,out] ops The number of Montgomery multiplications this call
+ *                   may do; decremented by the number done. A budget of at
+ *                   least 2 always makes progress.
+ *
+ * \return           0 when X is complete.
+ * \return           1 if the budget ran out first.
+ */
+int mbedtls_mpi_core_exp_mod_restartable(mbedtls_mpi_uint *X,
+                                         const mbedtls_mpi_uint *A,
+                                         const mbedtls_mpi_uint *N, size_t AN_limbs,
+                                         const mbedtls_mpi_uint *E,
+                                         const mbedtls_mpi_uint *RR,
+                                         mbedtls_mpi_uint *T,
+                                         mbedtls_mpi_core_exp_mod_restart *rs,
+                                         size_t *ops);
+#endif /* MBEDTLS_RSA_RESTARTABLE */
+
 /**
  * \brief Subtract unsigned integer from known-size large unsigned integers.
  *        Return the borrow.
@@ -830,6 +830,62 @@
         );                                                   \
     }
 
+#if defined(MBEDTLS_MULADDC_CORTEX_M7) && defined(__thumb2__)
+/* Local extension: Cortex-M7 4-limb kernel.
+ *
+ * - LDRD/STRD move two limbs per instruction over the 64-bit bus (word
+ *   alignment is enough on Armv7-M).
+ * - Each UMAAL is paired with a load or store, which the M7 can
+ *   dual-issue, instead of bunching all loads first as in
+ *   MULADDC_X2_CORE.
+ * - The multiplier word and the carry stay in registers for the whole
+ *   INIT..STOP block, so MULADDC_X8_CORE (two X4 bodies) keeps them
+ *   across 8 limbs. That is the unrolled loop of mbedtls_mpi_core_mla().
+ *
+ * 12 registers: 4 limbs of s, 4 of d, the two pointers, carry, scalar. */
+#define MULADDC_X4_INIT                              \
+    {                                                \
+        mbedtls_mpi_uint tmp_a0, tmp_b0;             \
+        mbedtls_mpi_uint tmp_a1, tmp_b1;             \
+        mbedtls_mpi_uint tmp_a2, tmp_b2;             \
+        mbedtls_mpi_uint tmp_a3, tmp_b3;             \
+        asm volatile (
+
+#define MULADDC_X4_CORE                                           \
+           ".p2align  2                                   \n\t"   \
+            "ldrd     %[a0], %[a1], [%[in]], #16          \n\t"   \
+            "ldrd     %[b0], %[b1], [%[acc]]              \n\t"   \
+            "umaal    %[b0], %[carry], %[scalar], %[a0]   \n\t"   \
+            "ldrd     %[a2], %[a3], [%[in], #-8]          \n\t"   \
+            "umaal    %[b1], %[carry], %[scalar], %[a1]   \n\t"   \
+            "ldrd     %[b2], %[b3], [%[acc], #8]          \n\t"   \
+            "umaal    %[b2], %[carry], %[scalar], %[a2]   \n\t"   \
+            "strd     %[b0], %[b1], [%[acc]], #16         \n\t"   \
+            "umaal    %[b3], %[carry], %[scalar], %[a3]   \n\t"   \
+            "strd     %[b2], %[b3], [%[acc], #-8]         \n\t"
+
+#define MULADDC_X4_STOP                                      \
+            : [a0]     "=&r" (tmp_a0),                       \
+              [b0]     "=&r" (tmp_b0),                       \
+              [a1]     "=&r" (tmp_a1),                       \
+              [b1]     "=&r" (tmp_b1),                       \
+              [a2]     "=&r" (tmp_a2),                       \
+              [b2]     "=&r" (tmp_b2),                       \
+              [a3]     "=&r" (tmp_a3),                       \
+              [b3]     "=&r" (tmp_b3),                       \
+              [in]     "+r"  (s),                            \
+              [acc]    "+r"  (d),                            \
+              [carry]  "+r"  (c)                             \
+            : [scalar] "r"   (b)                             \
+            : "memory"                                       \
+        );                                                   \
+    }
+
+#define MULADDC_X8_INIT MULADDC_X4_INIT
+#define MULADDC_X8_CORE MULADDC_X4_CORE MULADDC_X4_CORE
+#define MULADDC_X8_STOP MULADDC_X4_STOP
+#endif /* MBEDTLS_MULADDC_CORTEX_M7 */
+
 #else /* Thumb 2 or Arm ISA, without DSP extensions */
 
 #define MULADDC_X1_INIT                                 \
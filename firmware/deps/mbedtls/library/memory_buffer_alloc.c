@@ -613,6 +613,17 @@ void mbedtls_memory_buffer_alloc_free(void)
     mbedtls_platform_zeroize(&heap, sizeof(buffer_alloc_ctx));
 }
 
+/* Local extension: the allocator without the platform hooks */
+void *mbedtls_memory_buffer_calloc(size_t n, size_t size)
+{
+    return buffer_alloc_calloc(n, size);
+}
+
+void mbedtls_memory_buffer_free(void *ptr)
+{
+    buffer_alloc_free(ptr);
+}
+
 #if defined(MBEDTLS_SELF_TEST)
 static int check_pointer(void *p)
 {
@@ -48,6 +48,10 @@
 #include "mbedtls/constant_time.h"
 #include "md_psa.h"
 
+#if defined(MBEDTLS_RSA_RESTARTABLE)
+#include "bignum_core.h"
+#endif
+
 #include <string.h>
 
 #if defined(MBEDTLS_PKCS1_V15) && !defined(__OpenBSD__) && !defined(__NetBSD__)
@@ -1220,6 +1224,284 @@ cleanup:
     return ret;
 }
 
+#if defined(MBEDTLS_RSA_RESTARTABLE)
+
+#if defined(MBEDTLS_RSA_NO_CRT)
+#error "MBEDTLS_RSA_RESTARTABLE requires the CRT (undefine MBEDTLS_RSA_NO_CRT)"
+#endif
+
+/* Smallest budget per call: one exponent bit modulo N (square plus window
+ * multiplication, 4 each), so every call makes progress */
+#define RSA_RS_MIN_OPS 8
+
+static unsigned rsa_max_ops = 0;
+
+void mbedtls_rsa_set_max_ops(unsigned max_ops)
+{
+    rsa_max_ops = max_ops;
+}
+
+enum {
+    RSA_RS_BLIND = 0,       /* blind input and exponents */
+    RSA_RS_EXP_P,           /* TP = T^DP mod P */
+    RSA_RS_EXP_Q,           /* TQ = T^DQ mod Q */
+    RSA_RS_CRT,             /* recombine, unblind */
+    RSA_RS_CHECK,           /* TP = T^E mod N, compare with the input */
+};
+
+/* Exponentiation in progress: A in Montgomery form, the accumulator and
+ * the working memory of mbedtls_mpi_core_exp_mod_restartable() */
+struct mbedtls_rsa_restart_exp {
+    mbedtls_mpi_core_exp_mod_restart core;
+    mbedtls_mpi_uint *ws;
+    size_t ws_limbs;
+};
+
+static void rsa_restart_exp_free(mbedtls_rsa_restart_ctx *rs_ctx)
+{
+    if (rs_ctx->exp != NULL) {
+        mbedtls_zeroize_and_free(rs_ctx->exp->ws, rs_ctx->exp->ws_limbs * ciL);
+        mbedtls_free(rs_ctx->exp);
+        rs_ctx->exp = NULL;
+    }
+}
+
+void mbedtls_rsa_restart_init(mbedtls_rsa_restart_ctx *rs_ctx)
+{
+    rs_ctx->state = RSA_RS_BLIND;
+    mbedtls_mpi_init(&rs_ctx->T);
+    mbedtls_mpi_init(&rs_ctx->I);
+    mbedtls_mpi_init(&rs_ctx->Vf);
+    mbedtls_mpi_init(&rs_ctx->DP);
+    mbedtls_mpi_init(&rs_ctx->DQ);
+    mbedtls_mpi_init(&rs_ctx->TP);
+    mbedtls_mpi_init(&rs_ctx->TQ);
+    rs_ctx->exp = NULL;
+}
+
+void mbedtls_rsa_restart_free(mbedtls_rsa_restart_ctx *rs_ctx)
+{
+    if (rs_ctx == NULL) {
+        return;
+    }
+
+    rsa_restart_exp_free(rs_ctx);
+    mbedtls_mpi_free(&rs_ctx->T);
+    mbedtls_mpi_free(&rs_ctx->I);
+    mbedtls_mpi_free(&rs_ctx->Vf);
+    mbedtls_mpi_free(&rs_ctx->DP);
+    mbedtls_mpi_free(&rs_ctx->DQ);
+    mbedtls_mpi_free(&rs_ctx->TP);
+    mbedtls_mpi_free(&rs_ctx->TQ);
+    rs_ctx->state = RSA_RS_BLIND;
+}
+
+/*
+ * X = A^E mod N within *budget basic operations, one Montgomery
+ * multiplication costing weight. RR is the cached R^2 mod N of the key.
+ */
+static int rsa_exp_mod_restartable(mbedtls_rsa_restart_ctx *rs_ctx,
+                                   mbedtls_mpi *X, const mbedtls_mpi *A,
+                                   const mbedtls_mpi *E, const mbedtls_mpi *N,
+                                   mbedtls_mpi *RR, size_t weight,
+                                   size_t *budget)
+{
+    int ret = MBEDTLS_ERR_ERROR_CORRUPTION_DETECTED;
+    const size_t n = N->n;
+    struct mbedtls_rsa_restart_exp *exp = rs_ctx->exp;
+    size_t ops, left;
+
+    if (exp == NULL) {
+        const size_t E_bits = mbedtls_mpi_bitlen(E);
+        const size_t E_limbs = (E_bits + biL - 1) / biL;
+
+        if (E_bits == 0) {
+            return MBEDTLS_ERR_RSA_BAD_INPUT_DATA;
+        }
+        if (RR->p == NULL) {
+            MBEDTLS_MPI_CHK(mbedtls_mpi_core_get_mont_r2_unsafe(RR, N));
+        }
+        MBEDTLS_MPI_CHK(mbedtls_mpi_grow(RR, n));
+        MBEDTLS_MPI_CHK(mbedtls_mpi_mod_mpi(X, A, N));
+        MBEDTLS_MPI_CHK(mbedtls_mpi_grow(X, n));
+
+        exp = mbedtls_calloc(1, sizeof(*exp));
+        if (exp == NULL) {
+            return MBEDTLS_ERR_MPI_ALLOC_FAILED;
+        }
+        /* A in Montgomery form | accumulator | exp_mod working memory */
+        exp->ws_limbs = 2 * n + mbedtls_mpi_core_exp_mod_working_limbs(n, E_limbs);
+        exp->ws = mbedtls_calloc(exp->ws_limbs, ciL);
+        if (exp->ws == NULL) {
+            mbedtls_free(exp);
+            return MBEDTLS_ERR_MPI_ALLOC_FAILED;
+        }
+        rs_ctx->exp = exp;
+
+        mbedtls_mpi_core_exp_mod_restart_init(&exp->core, N->p, E_bits);
+        mbedtls_mpi_core_to_mont_rep(exp->ws, X->p, N->p, n, exp->core.mm,
+                                     RR->p, exp->ws + 2 * n);
+    }
+
+    ops = left = *budget / weight;
+    if (mbedtls_mpi_core_exp_mod_restartable(exp->ws + n, exp->ws, N->p, n,
+                                             E->p, RR->p, exp->ws + 2 * n,
+                                             &exp->core, &left) != 0) {
+        *budget = 0;
+        return MBEDTLS_ERR_RSA_IN_PROGRESS;
+    }
+    *budget -= (ops - left) * weight;
+
+    mbedtls_mpi_core_from_mont_rep(X->p, exp->ws + n, N->p, n, exp->core.mm,
+                                   exp->ws + 2 * n);
+    rsa_restart_exp_free(rs_ctx);
+    ret = 0;
+
+cleanup:
+    return ret;
+}
+
+/*
+ * Restartable RSA private key operation (CRT), see mbedtls_rsa_private()
+ */
+int mbedtls_rsa_private_restartable(mbedtls_rsa_context *ctx,
+                                    int (*f_rng)(void *, unsigned char *, size_t),
+                                    void *p_rng,
+                                    const unsigned char *input,
+                                    unsigned char *output,
+                                    mbedtls_rsa_restart_ctx *rs_ctx)
+{
+    int ret = MBEDTLS_ERR_ERROR_CORRUPTION_DETECTED;
+    size_t budget, max_ops;
+    mbedtls_mpi P1, Q1, R;
+
+    if (f_rng == NULL || rs_ctx == NULL) {
+        return MBEDTLS_ERR_RSA_BAD_INPUT_DATA;
+    }
+
+    if (rsa_check_context(ctx, 1 /* private key checks */,
+                          1 /* blinding on        */) != 0) {
+        return MBEDTLS_ERR_RSA_BAD_INPUT_DATA;
+    }
+
+    max_ops = rsa_max_ops == 0 ? (size_t) -1 :
+              rsa_max_ops < RSA_RS_MIN_OPS ? RSA_RS_MIN_OPS : rsa_max_ops;
+    budget = max_ops;
+
+#if defined(MBEDTLS_THREADING_C)
+    if ((ret = mbedtls_mutex_lock(&ctx->mutex)) != 0) {
+        return ret;
+    }
+#endif
+
+    mbedtls_mpi_init(&P1);
+    mbedtls_mpi_init(&Q1);
+    mbedtls_mpi_init(&R);
+
+    if (rs_ctx->state == RSA_RS_BLIND) {
+        MBEDTLS_MPI_CHK(mbedtls_mpi_read_binary(&rs_ctx->T, input, ctx->len));
+        if (mbedtls_mpi_cmp_mpi(&rs_ctx->T, &ctx->N) >= 0) {
+            ret = MBEDTLS_ERR_MPI_BAD_INPUT_DATA;
+            goto cleanup;
+        }
+        MBEDTLS_MPI_CHK(mbedtls_mpi_copy(&rs_ctx->I, &rs_ctx->T));
+
+        /* T = T * Vi mod N; the context's Vf moves on with the next
+         * operation, so keep this one's */
+        MBEDTLS_MPI_CHK(rsa_prepare_blinding(ctx, f_rng, p_rng));
+        MBEDTLS_MPI_CHK(mbedtls_mpi_copy(&rs_ctx->Vf, &ctx->Vf));
+        MBEDTLS_MPI_CHK(mbedtls_mpi_mul_mpi(&rs_ctx->T, &rs_ctx->T, &ctx->Vi));
+        MBEDTLS_MPI_CHK(mbedtls_mpi_mod_mpi(&rs_ctx->T, &rs_ctx->T, &ctx->N));
+
+        /* DP_blind = ( P - 1 ) * R + DP, DQ_blind = ( Q - 1 ) * R + DQ */
+        MBEDTLS_MPI_CHK(mbedtls_mpi_sub_int(&P1, &ctx->P, 1));
+        MBEDTLS_MPI_CHK(mbedtls_mpi_sub_int(&Q1, &ctx->Q, 1));
+        MBEDTLS_MPI_CHK(mbedtls_mpi_fill_random(&R, RSA_EXPONENT_BLINDING,
+                                                f_rng, p_rng));
+        MBEDTLS_MPI_CHK(mbedtls_mpi_mul_mpi(&rs_ctx->DP, &P1, &R));
+        MBEDTLS_MPI_CHK(mbedtls_mpi_add_mpi(&rs_ctx->DP, &rs_ctx->DP, &ctx->DP));
+        MBEDTLS_MPI_CHK(mbedtls_mpi_fill_random(&R, RSA_EXPONENT_BLINDING,
+                                                f_rng, p_rng));
+        MBEDTLS_MPI_CHK(mbedtls_mpi_mul_mpi(&rs_ctx->DQ, &Q1, &R));
+        MBEDTLS_MPI_CHK(mbedtls_mpi_add_mpi(&rs_ctx->DQ, &rs_ctx->DQ, &ctx->DQ));
+
+        rs_ctx->state = RSA_RS_EXP_P;
+    }
+
+    if (rs_ctx->state == RSA_RS_EXP_P) {
+        MBEDTLS_MPI_CHK(rsa_exp_mod_restartable(rs_ctx, &rs_ctx->TP, &rs_ctx->T,
+                                                &rs_ctx->DP, &ctx->P, &ctx->RP,
+                                                1, &budget));
+        rs_ctx->state = RSA_RS_EXP_Q;
+    }
+
+    if (rs_ctx->state == RSA_RS_EXP_Q) {
+        MBEDTLS_MPI_CHK(rsa_exp_mod_restartable(rs_ctx, &rs_ctx->TQ, &rs_ctx->T,
+                                                &rs_ctx->DQ, &ctx->Q, &ctx->RQ,
+                                                1, &budget));
+        rs_ctx->state = RSA_RS_CRT;
+    }
+
+    if (rs_ctx->state == RSA_RS_CRT) {
+        /* Recombination as in mbedtls_rsa_private(); it is not budgeted,
+         * so start it at the beginning of a call rather than on top of
+         * the exponentiation modulo Q */
+        if (rsa_max_ops != 0 && budget < max_ops) {
+            ret = MBEDTLS_ERR_RSA_IN_PROGRESS;
+            goto cleanup;
+        }
+
+        /* T = ((TP - TQ) * (Q^-1 mod P) mod P) * Q + TQ */
+        MBEDTLS_MPI_CHK(mbedtls_mpi_sub_mpi(&rs_ctx->T, &rs_ctx->TP, &rs_ctx->TQ));
+        MBEDTLS_MPI_CHK(mbedtls_mpi_mul_mpi(&rs_ctx->TP, &rs_ctx->T, &ctx->QP));
+        MBEDTLS_MPI_CHK(mbedtls_mpi_mod_mpi(&rs_ctx->T, &rs_ctx->TP, &ctx->P));
+        MBEDTLS_MPI_CHK(mbedtls_mpi_mul_mpi(&rs_ctx->TP, &rs_ctx->T, &ctx->Q));
+        MBEDTLS_MPI_CHK(mbedtls_mpi_add_mpi(&rs_ctx->T, &rs_ctx->TQ, &rs_ctx->TP));
+
+        /* Unblind: T = T * Vf mod N */
+        MBEDTLS_MPI_CHK(mbedtls_mpi_mul_mpi(&rs_ctx->T, &rs_ctx->T, &rs_ctx->Vf));
+        MBEDTLS_MPI_CHK(mbedtls_mpi_mod_mpi(&rs_ctx->T, &rs_ctx->T, &ctx->N));
+
+        rs_ctx->state = RSA_RS_CHECK;
+    }
+
+    /* Verify the result to prevent glitching attacks. */
+    MBEDTLS_MPI_CHK(rsa_exp_mod_restartable(rs_ctx, &rs_ctx->TP, &rs_ctx->T,
+                                            &ctx->E, &ctx->N, &ctx->RN,
+                                            4, &budget));
+    if (mbedtls_mpi_cmp_mpi(&rs_ctx->TP, &rs_ctx->I) != 0) {
+        ret = MBEDTLS_ERR_RSA_VERIFY_FAILED;
+        goto cleanup;
+    }
+
+    MBEDTLS_MPI_CHK(mbedtls_mpi_write_binary(&rs_ctx->T, output, ctx->len));
+
+cleanup:
+#if defined(MBEDTLS_THREADING_C)
+    if (mbedtls_mutex_unlock(&ctx->mutex) != 0) {
+        return MBEDTLS_ERR_THREADING_MUTEX_ERROR;
+    }
+#endif
+
+    mbedtls_mpi_free(&P1);
+    mbedtls_mpi_free(&Q1);
+    mbedtls_mpi_free(&R);
+
+    if (ret == MBEDTLS_ERR_RSA_IN_PROGRESS) {
+        return ret;
+    }
+
+    /* Done or failed: ready for the next operation */
+    mbedtls_rsa_restart_free(rs_ctx);
+
+    if (ret != 0 && ret >= -0x007f) {
+        return MBEDTLS_ERROR_ADD(MBEDTLS_ERR_RSA_PRIVATE_FAILED, ret);
+    }
+
+    return ret;
+}
+#endif /* MBEDTLS_RSA_RESTARTABLE */
+
 #if defined(MBEDTLS_PKCS1_V21)
 /**
  * Generate and apply the MGF1 operation (from PKCS#1 v2.1) to a buffer.
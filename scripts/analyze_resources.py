@@ -10,7 +10,7 @@ def parse_map_file(map_file):
 
     # Modules definition
     modules = {
-        "mbedTLS (RSA)": {"rom": 0, "ram": 0, "patterns": ["mbedtls", "RSA/Src"]},
+        "mbedTLS (RSA)": {"rom": 0, "ram": 0, "patterns": ["mbedtls", "RSA/Src", "rsa_keystore"]},
         "ML-KEM-512": {"rom": 0, "ram": 0, "patterns": ["ml-kem-512"]},
         "ML-DSA-44": {"rom": 0, "ram": 0, "patterns": ["ml-dsa-44"]},
         "Falcon-512": {"rom": 0, "ram": 0, "patterns": ["falcon-512"]},
@@ -0,0 +1,114 @@
+"""Generates the flash-resident RSA key store (firmware/Core/Src/rsa_keystore.c).
+
+Run by the firmware and host builds (CMake custom command); writes one C
+file with the raw big-endian N, P, Q, D, E of a 2048, 3072 and 4096-bit key.
+The keys come from a fixed seed, so every build embeds the same keys and
+benchmark runs on different boards/hosts use identical operands.
+
+These keys are for benchmarking only: anyone can regenerate them.
+
+Usage:
+    python scripts/gen_rsa_keystore.py <output.c> [--seed N]
+"""
+import argparse
+import math
+import os
+import random
+
+KEY_SIZES = (2048, 3072, 4096)
+PUBLIC_EXPONENT = 65537
+DEFAULT_SEED = 0x5EED2048
+MR_ROUNDS = 40
+
+SMALL_PRIMES = [p for p in range(3, 2000) if all(p % d for d in range(2, int(p ** 0.5) + 1))]
+SMALL_PRIMORIAL = math.prod(SMALL_PRIMES)
+
+
+def is_probable_prime(n, rng):
+    """Trial division (one gcd with the small primes), then Miller-Rabin.
+
+    Only used for candidates far above the small primes."""
+    if math.gcd(n, SMALL_PRIMORIAL) != 1:
+        return False
+    d, s = n - 1, 0
+    while d % 2 == 0:
+        d //= 2
+        s += 1
+    for _ in range(MR_ROUNDS):
+        a = rng.randrange(2, n - 1)
+        x = pow(a, d, n)
+        if x in (1, n - 1):
+            continue
+        for _ in range(s - 1):
+            x = pow(x, 2, n)
+            if x == n - 1:
+                break
+        else:
+            return False
+    return True
+
+
+def gen_prime(bits, rng):
+    """Random prime with the top two bits set, so p * q has exactly 2 * bits bits."""
+    while True:
+        p = rng.getrandbits(bits) | (3 << (bits - 2)) | 1
+        if math.gcd(p - 1, PUBLIC_EXPONENT) == 1 and is_probable_prime(p, rng):
+            return p
+
+
+def gen_key(bits, rng):
+    while True:
+        p = gen_prime(bits // 2, rng)
+        q = gen_prime(bits // 2, rng)
+        if p == q:
+            continue
+        if p < q:
+            p, q = q, p                  # mbedTLS convention: P > Q
+        lam = math.lcm(p - 1, q - 1)
+        return {"N": p * q, "P": p, "Q": q, "D": pow(PUBLIC_EXPONENT, -1, lam), "E": PUBLIC_EXPONENT}
+
+
+def c_array(name, value, length):
+    data = value.to_bytes(length, "big")
+    lines = [f"static const uint8_t {name}[{length}] = {{"]
+    for i in range(0, length, 16):
+        lines.append("    " + ", ".join(f"0x{b:02x}" for b in data[i:i + 16]) + ",")
+    lines.append("};")
+    return "\n".join(lines)
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument("output")
+    parser.add_argument("--seed", type=lambda s: int(s, 0), default=DEFAULT_SEED)
+    args = parser.parse_args()
+
+    rng = random.Random(args.seed)
+    out = [
+        f"/* Generated by scripts/gen_rsa_keystore.py (seed 0x{args.seed:x}); do not edit. */",
+        '#include "rsa_keystore.h"',
+        "",
+    ]
+    entries = []
+    for bits in KEY_SIZES:
+        key = gen_key(bits, rng)
+        lengths = {"N": bits // 8, "P": bits // 16, "Q": bits // 16, "D": bits // 8, "E": 3}
+        for part, length in lengths.items():
+            out.append(c_array(f"rsa{bits}_{part.lower()}", key[part], length))
+            out.append("")
+        fields = ", ".join(f"rsa{bits}_{p.lower()}, sizeof(rsa{bits}_{p.lower()})" for p in lengths)
+        entries.append(f"    {{ {bits}, {fields} }},")
+
+    out.append("const rsa_keystore_entry_t rsa_keystore[] = {")
+    out.extend(entries)
+    out.append("};")
+    out.append("")
+    out.append("const size_t rsa_keystore_count = sizeof(rsa_keystore) / sizeof(rsa_keystore[0]);")
+
+    os.makedirs(os.path.dirname(os.path.abspath(args.output)), exist_ok=True)
+    with open(args.output, "w", newline="\n") as f:
+        f.write("\n".join(out) + "\n")
+
+
+if __name__ == "__main__":
+    main()
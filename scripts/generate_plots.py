@@ -1,34 +1,7 @@
-import re
 import sys
 import matplotlib.pyplot as plt
 
-def parse_uart_log(filepath):
-    results = []
-    try:
-        with open(filepath, 'r', encoding='utf-8') as f:
-            content = f.read()
-    except UnicodeDecodeError:
-        with open(filepath, 'r', encoding='latin-1') as f:
-            content = f.read()
-
-    # Regex to capture: UART >> Algorithm: Operation took Cycles cycles, Stack: Stack bytes
-    pattern = r"(?:UART >>\s*)+(.*?): (.*?) took (\d+) cycles, Stack: (\d+) bytes"
-    matches = re.findall(pattern, content)
-
-    for match in matches:
-        alg, op, cycles, stack = match
-        cycles = int(cycles)
-        stack = int(stack)
-        time_ms = (cycles / 216000000) * 1000  # Assuming 216 MHz clk
-        results.append({
-            "Algorithm": alg.strip(),
-            "Operation": op.strip(),
-            "Cycles": cycles,
-            "Time_ms": round(time_ms, 2),
-            "Stack_Bytes": stack
-        })
-    
-    return results
+from telemetry import parse_uart_log
 
 def generate_plots(data, output_prefix="benchmark"):
     if not data:
@@ -28,7 +28,8 @@ if (-not $Command) {
     Write-Host "1) RSA Only (Fastest)"
     Write-Host "2) PQC Only"
     Write-Host "3) All (RSA + PQC)"
-    $choice = Read-Host "Select option [1-3] (Default: 3)"
+    Write-Host "7) RSA KeyGen (slow, not part of 1 or 3)"
+    $choice = Read-Host "Select option [1-3, 7] (Default: 3)"
     if ([string]::IsNullOrWhiteSpace($choice)) { $choice = "3" }
     $Command = $choice
 }
@@ -1,4 +1,11 @@
 # Run Build in Container
+#   .\scripts\run_build.ps1             -> default targets plus pqc_demo_tlsf.elf
+#   .\scripts\run_build.ps1 profiles    -> all pqc_demo_<O2|O3|Os>[_lto].elf variants
+#   .\scripts\run_build.ps1 pqc_demo_O3_lto.elf
+#   .\scripts\run_build.ps1 pqc_demo_muladdc_m7.elf      -> Cortex-M7 MULADDC kernel
+#   .\scripts\run_build.ps1 pqc_demo_tlsf.elf            -> TLSF instead of newlib malloc
+param([string]$Target = "")
+
 $ErrorActionPreference = "Stop"
 
 $ProjectRoot = "C:\Daten\Projekte\AUTOMO~1\2026_V~1\SAFE~1.TEC\demos\pqc"
@@ -20,7 +27,12 @@ Write-Host "Running Build inside Container..."
 # We use toolchain_container.cmake relative to build dir (which is inside firmware)
 # So ../toolchain_container.cmake is correct.
 # And source dir is ..
-$BuildCmd = "mkdir -p build && cd build && cmake -G Ninja -DCMAKE_TOOLCHAIN_FILE=../toolchain_container.cmake .. && ninja"
+# Without a target: everything in the default build, plus the TLSF image so
+# its malloc overrides are link-checked against newlib-nano on every build
+if ($Target -eq "") {
+    $Target = "all pqc_demo_tlsf.elf"
+}
+$BuildCmd = "mkdir -p build && cd build && cmake -G Ninja -DCMAKE_TOOLCHAIN_FILE=../toolchain_container.cmake .. && ninja $Target"
 
 # Volume mount: Host Path : Container Path
 # Workdir: where we run the command
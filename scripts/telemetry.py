@@ -0,0 +1,260 @@
+"""Shared parser for benchmark logs captured from the board (or pqc_demo_host).
+
+Understands both output formats of crypto_harness.c:
+  * binary telemetry frames (firmware/Core/Inc/telemetry.h), and
+  * the legacy "UART >> ALG: OP took N cycles, Stack: S bytes" text lines.
+
+Usage as a library:
+    from telemetry import parse_uart_log, parse_uart_stats
+Usage from the command line (dump decoded records):
+    python scripts/telemetry.py benchmarks.log
+"""
+import math
+import os
+import re
+import struct
+import sys
+
+CPU_HZ = 216000000
+
+TELEMETRY_VERSION = 3
+# version, alg, op, flags, iteration, cycles, stack, heap, allocs, frees, alloc cycles, worst alloc call
+PAYLOAD_FMT = "<BBBBHQIIHHII"
+PAYLOAD_LEN = struct.calcsize(PAYLOAD_FMT)
+FLAG_FAILED = 0x01
+FLAG_COLD = 0x02                     # caches flushed before the op
+FLAG_CHECK = 0x04                    # with FLAG_FAILED: op succeeded, result was wrong
+
+# Keep in sync with telemetry_alg_t / telemetry_op_t
+ALGORITHMS = {
+    1: "ML-DSA-44",
+    2: "ML-KEM-512",
+    3: "Falcon-512",
+    4: "SPHINCS+",
+    5: "RSA-2048",
+    6: "RSA-3072",
+    7: "RSA-4096",
+    8: "BigInt-2048",
+    9: "BigInt-3072",
+    10: "BigInt-4096",
+}
+
+OPERATIONS = {
+    1: "Keygen",
+    2: "Sign",
+    3: "Verify",
+    4: "Encaps",
+    5: "Decaps",
+    6: "Public Op",
+    7: "Private Op",
+    8: "Public Op Ref",
+    9: "Private Op VT",
+    10: "Mul",
+    11: "Mul Crossover",
+    12: "Private Op CRT",
+    13: "Public Mont",
+    14: "Public Barrett",
+    15: "Public Mont Keyed",
+    16: "Public Barrett Keyed",
+    17: "KeyGen Stock",
+    18: "Private Op Sliced",
+    19: "Public Op Arena",
+    20: "Private Op Arena",
+    21: "Public Op Buffer Alloc",
+    22: "Private Op Buffer Alloc",
+}
+
+TEXT_RESULT = re.compile(r"(?:UART >>\s*)+(.*?): (.*?) took (\d+) cycles, Stack: (\d+) bytes"
+                         r"(?:, Heap: (\d+) bytes \((\d+) allocs, (\d+) frees\))?"
+                         r"(?:, Alloc: (\d+) cycles \(worst call (\d+)\))?")
+TEXT_BUILD = re.compile(r"(?:UART >>\s*)+Build profile: (\S+) \((.*?)\)")
+TEXT_STATS = re.compile(r"(?:UART >>\s*)+(.*?): (.*?) stats: n=(\d+) min=(\d+) median=(\d+) "
+                        r"p90=(\d+) max=(\d+) stddev=(\d+)")
+
+
+def crc16(data):
+    """CRC-16/CCITT-FALSE, as telemetry_crc16()."""
+    crc = 0xFFFF
+    for byte in data:
+        crc ^= byte << 8
+        for _ in range(8):
+            crc = ((crc << 1) ^ 0x1021) if crc & 0x8000 else (crc << 1)
+            crc &= 0xFFFF
+    return crc
+
+
+def cobs_decode(data):
+    """Decodes one COBS block (without delimiters). Returns None if malformed."""
+    out = bytearray()
+    i = 0
+    while i < len(data):
+        code = data[i]
+        end = i + code
+        if code == 0 or end > len(data):
+            return None
+        out += data[i + 1:end]
+        i = end
+        if code < 0xFF and i < len(data):
+            out.append(0)
+    return bytes(out)
+
+
+def op_name(alg, op_id):
+    name = OPERATIONS.get(op_id, f"Op{op_id}")
+    # The RSA suite has always spelled it "KeyGen"; keep report keys stable
+    if name == "Keygen" and alg.startswith("RSA"):
+        return "KeyGen"
+    return name
+
+
+def decode_frames(content):
+    """Extracts every valid record from raw bytes; text and noise are skipped."""
+    records = []
+    for chunk in content.split(b"\x00"):
+        if not chunk:
+            continue
+        raw = cobs_decode(chunk)
+        if raw is None or len(raw) != PAYLOAD_LEN + 2:
+            continue
+        payload, crc = raw[:PAYLOAD_LEN], struct.unpack("<H", raw[PAYLOAD_LEN:])[0]
+        if crc16(payload) != crc:
+            continue
+        version, alg_id, op_id, flags, iteration, cycles, stack, heap, allocs, frees, \
+            alloc_cycles, alloc_worst = struct.unpack(PAYLOAD_FMT, payload)
+        if version != TELEMETRY_VERSION:
+            continue
+        alg = ALGORITHMS.get(alg_id, f"Alg{alg_id}")
+        op = op_name(alg, op_id)
+        # Same naming as the text lines, so cold results never mix with warm ones
+        if flags & FLAG_COLD:
+            op += " (cold)"
+        records.append({
+            "Algorithm": alg,
+            "Operation": op,
+            "Failed": bool(flags & FLAG_FAILED),
+            "Check_Failed": bool(flags & FLAG_CHECK),
+            "Iteration": iteration,
+            "Cycles": cycles,
+            "Stack_Bytes": stack,
+            "Heap_Bytes": heap,
+            "Heap_Allocs": allocs,
+            "Heap_Frees": frees,
+            "Alloc_Cycles": alloc_cycles,
+            "Alloc_Worst": alloc_worst,
+        })
+    return records
+
+
+def _read(filepath):
+    if not os.path.exists(filepath):
+        print(f"Warning: {filepath} not found.")
+        return None
+    with open(filepath, "rb") as f:
+        return f.read()
+
+
+def _group_samples(records):
+    groups = {}
+    for r in records:
+        if r["Failed"]:
+            continue
+        groups.setdefault((r["Algorithm"], r["Operation"]), []).append(r)
+    return groups
+
+
+def _median(values):
+    v = sorted(values)
+    n = len(v)
+    return v[n // 2] if n % 2 else v[n // 2 - 1] + (v[n // 2] - v[n // 2 - 1]) // 2
+
+
+def _result(alg, op, cycles, stack, heap=0, allocs=0, frees=0, alloc_cycles=0, alloc_worst=0):
+    return {
+        "Algorithm": alg.strip(),
+        "Operation": op.strip(),
+        "Cycles": cycles,
+        "Time_ms": round((cycles / CPU_HZ) * 1000, 2),
+        "Stack_Bytes": stack,
+        "Heap_Bytes": heap,
+        "Heap_Allocs": allocs,
+        "Heap_Frees": frees,
+        "Alloc_Cycles": alloc_cycles,
+        "Alloc_Worst": alloc_worst,
+    }
+
+
+def parse_uart_log(filepath):
+    """One result per measured operation: median cycles, peak stack/heap/allocator cycles."""
+    content = _read(filepath)
+    if content is None:
+        return []
+
+    results = []
+    for (alg, op), runs in _group_samples(decode_frames(content)).items():
+        results.append(_result(alg, op, _median([r["Cycles"] for r in runs]),
+                               max(r["Stack_Bytes"] for r in runs),
+                               max(r["Heap_Bytes"] for r in runs),
+                               max(r["Heap_Allocs"] for r in runs),
+                               max(r["Heap_Frees"] for r in runs),
+                               max(r["Alloc_Cycles"] for r in runs),
+                               max(r["Alloc_Worst"] for r in runs)))
+
+    text = content.decode("utf-8", errors="ignore")
+    for alg, op, cycles, stack, heap, allocs, frees, alloc_cycles, alloc_worst in TEXT_RESULT.findall(text):
+        results.append(_result(alg, op, int(cycles), int(stack), int(heap or 0),
+                               int(allocs or 0), int(frees or 0),
+                               int(alloc_cycles or 0), int(alloc_worst or 0)))
+    return results
+
+
+def parse_build_profile(filepath):
+    """Build profile header of the log, e.g. "O3_lto (GCC 13.2.1)", or None."""
+    content = _read(filepath)
+    if content is None:
+        return None
+    match = TEXT_BUILD.search(content.decode("utf-8", errors="ignore"))
+    return f"{match.group(1)} ({match.group(2)})" if match else None
+
+
+def parse_uart_stats(filepath):
+    """min/median/p90/max/stddev per operation (from binary samples or stats lines)."""
+    content = _read(filepath)
+    if content is None:
+        return []
+
+    stats = []
+    for (alg, op), runs in _group_samples(decode_frames(content)).items():
+        v = sorted(r["Cycles"] for r in runs)
+        n = len(v)
+        mean = sum(v) / n
+        sd = math.sqrt(sum((x - mean) ** 2 for x in v) / (n - 1)) if n > 1 else 0.0
+        stats.append({
+            "Algorithm": alg, "Operation": op, "N": n,
+            "Min": v[0], "Median": _median(v), "P90": v[math.ceil(0.9 * n) - 1],
+            "Max": v[-1], "Stddev": int(round(sd))
+        })
+
+    text = content.decode("utf-8", errors="ignore")
+    for match in TEXT_STATS.findall(text):
+        n, mn, med, p90, mx, sd = (int(v) for v in match[2:])
+        stats.append({
+            "Algorithm": match[0].strip(), "Operation": match[1].strip(), "N": n,
+            "Min": mn, "Median": med, "P90": p90, "Max": mx, "Stddev": sd
+        })
+    return stats
+
+
+if __name__ == "__main__":
+    if len(sys.argv) < 2:
+        print("Usage: python telemetry.py <log_file>")
+        sys.exit(1)
+    data = _read(sys.argv[1]) or b""
+    for rec in decode_frames(data):
+        if rec["Check_Failed"]:
+            status = "FAILED (wrong result)"
+        else:
+            status = "FAILED" if rec["Failed"] else f"{rec['Cycles']} cycles"
+        print(f"{rec['Algorithm']:<12} {rec['Operation']:<12} #{rec['Iteration']:<3} {status}, "
+              f"Stack: {rec['Stack_Bytes']} B, Heap: {rec['Heap_Bytes']} B "
+              f"({rec['Heap_Allocs']} allocs, {rec['Heap_Frees']} frees), "
+              f"Alloc: {rec['Alloc_Cycles']} cycles (worst call {rec['Alloc_Worst']})")
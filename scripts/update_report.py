@@ -2,30 +2,7 @@ import re
 import sys
 import os
 
-def parse_uart_log(filepath):
-    if not os.path.exists(filepath):
-        print(f"Warning: {filepath} not found.")
-        return []
-    with open(filepath, 'rb') as f:
-        content = f.read().decode('utf-8', errors='ignore')
-
-    pattern = r"(?:UART >>\s*)+(.*?): (.*?) took (\d+) cycles, Stack: (\d+) bytes"
-    matches = re.findall(pattern, content)
-
-    results = []
-    for match in matches:
-        alg, op, cycles, stack = match
-        cycles = int(cycles)
-        stack = int(stack)
-        time_ms = (cycles / 216000000) * 1000
-        results.append({
-            "Algorithm": alg.strip(),
-            "Operation": op.strip(),
-            "Cycles": cycles,
-            "Time_ms": round(time_ms, 2),
-            "Stack_Bytes": stack
-        })
-    return results
+from telemetry import parse_uart_log, parse_uart_stats, parse_build_profile
 
 def parse_map_file(map_file):
     if not os.path.exists(map_file):
@@ -33,7 +10,7 @@ def parse_map_file(map_file):
         return None
 
     modules = {
-        "mbedTLS (RSA)": {"rom": 0, "ram": 0, "patterns": ["mbedtls", "RSA/Src"]},
+        "mbedTLS (RSA)": {"rom": 0, "ram": 0, "patterns": ["mbedtls", "RSA/Src", "rsa_keystore"]},
         "ML-KEM-512": {"rom": 0, "ram": 0, "patterns": ["ml-kem-512"]},
         "ML-DSA-44": {"rom": 0, "ram": 0, "patterns": ["ml-dsa-44"]},
         "Falcon-512": {"rom": 0, "ram": 0, "patterns": ["falcon-512"]},
@@ -92,7 +69,13 @@ CLEAN_C_BASELINE = {
     ("ML-DSA-44", "Sign"): 57625468,
 }
 
+COLD_SUFFIX = " (cold)"
+
+def warm_only(results):
+    return [r for r in results if not r['Operation'].endswith(COLD_SUFFIX)]
+
 def generate_performance_table(results):
+    results = warm_only(results)
     header = "| Algorithm | Operation | Clean C (M4) | Assembly (M5) | Speedup |\n| :--- | :--- | ---: | ---: | :--- |"
     rows = []
     
@@ -120,13 +103,82 @@ def generate_stack_table(results):
     header = "| Algorithm | Operation | Peak Stack (Bytes) |\n| :--- | :--- | ---: |"
     rows = []
     seen = set()
-    for r in results:
+    for r in warm_only(results):
         key = (r['Algorithm'], r['Operation'])
         if key in seen: continue
         seen.add(key)
         rows.append(f"| {r['Algorithm']} | {r['Operation']} | {r['Stack_Bytes']:,} |")
     return header + "\n" + "\n".join(rows)
 
+def generate_stats_table(stats):
+    if not stats:
+        return None
+    header = ("| Algorithm | Operation | Runs | Min | Median | P90 | Max | Stddev (%) |\n"
+              "| :--- | :--- | ---: | ---: | ---: | ---: | ---: | ---: |")
+    rows = []
+    for r in stats:
+        rel = (100.0 * r['Stddev'] / r['Median']) if r['Median'] else 0.0
+        rows.append(f"| {r['Algorithm']} | {r['Operation']} | {r['N']} | {r['Min']:,} | {r['Median']:,} | "
+                    f"{r['P90']:,} | {r['Max']:,} | {rel:.1f} |")
+    return header + "\n" + "\n".join(rows)
+
+def generate_cache_table(results):
+    warm = {(r['Algorithm'], r['Operation']): r['Cycles'] for r in warm_only(results)}
+    rows = []
+    for r in results:
+        if not r['Operation'].endswith(COLD_SUFFIX):
+            continue
+        op = r['Operation'][:-len(COLD_SUFFIX)]
+        w = warm.get((r['Algorithm'], op))
+        if not w:
+            continue
+        penalty = 100.0 * (r['Cycles'] - w) / w
+        rows.append(f"| {r['Algorithm']} | {op} | {w:,} | {r['Cycles']:,} | {penalty:+.1f}% |")
+    if not rows:
+        return None
+    header = ("| Algorithm | Operation | Warm (Cycles) | Cold (Cycles) | Cold Penalty |\n"
+              "| :--- | :--- | ---: | ---: | ---: |")
+    return header + "\n" + "\n".join(rows)
+
+def generate_ram_table(results, modules):
+    """Worst-case RAM per operation: peak stack + peak heap + static (.data/.bss),
+    with the cycles spent in the allocator (total and slowest call)."""
+    static = sum(m['ram'] for m in modules.values()) if modules else 0
+    header = ("| Algorithm | Operation | Stack (B) | Heap (B) | Allocs | Alloc (Cycles) | Worst Call (Cycles) | "
+              "Static (B) | Total RAM (B) |\n"
+              "| :--- | :--- | ---: | ---: | ---: | ---: | ---: | ---: | ---: |")
+    rows = []
+    for r in warm_only(results):
+        total = r['Stack_Bytes'] + r['Heap_Bytes'] + static
+        rows.append(f"| {r['Algorithm']} | {r['Operation']} | {r['Stack_Bytes']:,} | {r['Heap_Bytes']:,} | "
+                    f"{r['Heap_Allocs']:,} | {r['Alloc_Cycles']:,} | {r['Alloc_Worst']:,} | {static:,} | {total:,} |")
+    return header + "\n" + "\n".join(rows)
+
+NIST_LEVEL = {2048: "< 1", 3072: "1 (128-bit)", 4096: "> 1"}
+
+def generate_scalability_table(results):
+    """mbedTLS and the custom BigInt RSA per key size (warm runs)."""
+    cycles = {(r['Algorithm'], r['Operation']): r['Cycles'] for r in warm_only(results)}
+
+    def cell(alg, op):
+        c = cycles.get((alg, op))
+        return f"{c:,}" if c else "-"
+
+    rows = []
+    for bits, level in NIST_LEVEL.items():
+        rsa, bigint = f"RSA-{bits}", f"BigInt-{bits}"
+        if not any(alg in (rsa, bigint) for alg, _ in cycles):
+            continue
+        rows.append(f"| **RSA-{bits}** | {level} | {cell(rsa, 'KeyGen')} | {cell(rsa, 'Public Op')} | "
+                    f"{cell(bigint, 'Public Op')} | {cell(rsa, 'Private Op')} | {cell(bigint, 'Private Op')} | "
+                    f"{cell(bigint, 'Private Op CRT')} |")
+    if not rows:
+        return None
+    header = ("| Key Size | NIST Level | KeyGen (Cycles) | Public Op mbedTLS | Public Op BigInt | "
+              "Private Op mbedTLS (CRT) | Private Op BigInt | Private Op BigInt CRT |\n"
+              "| :--- | :--- | ---: | ---: | ---: | ---: | ---: | ---: |")
+    return header + "\n" + "\n".join(rows)
+
 def generate_resource_table(modules):
     total_rom = sum(m['rom'] for m in modules.values())
     total_ram = sum(m['ram'] for m in modules.values())
@@ -153,14 +205,21 @@ def generate_resource_table(modules):
 
 def update_report(report_path, log_path, map_path):
     results = parse_uart_log(log_path)
+    stats = parse_uart_stats(log_path)
+    profile = parse_build_profile(log_path)
     modules = parse_map_file(map_path)
     
     with open(report_path, 'r', encoding='utf-8') as f:
         content = f.read()
 
     replacements = {
+        "BUILD_PROFILE": f"Measured with build profile **{profile}**." if profile else None,
         "PERFORMANCE_TABLE": generate_performance_table(results),
         "STACK_TABLE": generate_stack_table(results),
+        "STATS_TABLE": generate_stats_table(stats),
+        "CACHE_TABLE": generate_cache_table(results),
+        "RAM_TABLE": generate_ram_table(results, modules),
+        "SCALABILITY_TABLE": generate_scalability_table(results),
         "RESOURCE_TABLE": generate_resource_table(modules) if modules else None
     }
 